@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+// Timing shared by the benchmark executables: every bench repeats a run
+// until enough time was measured and keeps the best run, which is the
+// least disturbed by the scheduler and cold caches.
+namespace Bench {
+
+    using Clock = std::chrono::steady_clock;
+
+    inline double Seconds(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Measures the region between Start() and Stop(); setup outside it is free
+    class Timer {
+    public:
+        void Start() { start = Clock::now(); }
+        void Stop() { seconds = Bench::Seconds(start); }
+        double Seconds() const { return seconds; }
+
+    private:
+        Clock::time_point start;
+        double seconds = 0.0;
+    };
+
+    struct Measurement {
+        double seconds = 1e30;   // best run
+        int runs = 0;
+    };
+
+    // Calls run(timer) until minSeconds of measured time and at least minRuns runs
+    template<typename Fn>
+    Measurement Measure(Fn&& run, double minSeconds = 0.5, int minRuns = 3) {
+        Measurement result;
+        double total = 0.0;
+        while (total < minSeconds || result.runs < minRuns) {
+            Timer timer;
+            run(timer);
+            result.seconds = std::min(result.seconds, timer.Seconds());
+            total += timer.Seconds();
+            result.runs++;
+        }
+        return result;
+    }
+
+    // Best time of a whole fn() call, in seconds
+    template<typename Fn>
+    double BestOf(Fn&& fn, double minSeconds = 0.5, int minRuns = 3) {
+        return Measure([&fn](Timer& timer) {
+            timer.Start();
+            fn();
+            timer.Stop();
+        }, minSeconds, minRuns).seconds;
+    }
+}
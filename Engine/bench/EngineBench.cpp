@@ -0,0 +1,318 @@
+// ECS benchmark suite: entity create/destroy, component add/remove, view and
+// group iteration, snapshot save/load, prefabs and transforms, at a range of
+// entity counts. Results are printed and written to a JSON file so runs can
+// be compared between releases.
+//
+// Run a Release build:
+//   ./EngineBench [--out results.json] [--counts 1000,10000,100000,1000000]
+//                 [--min-time 0.25] [--filter snapshot]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "entt.hpp"
+#include "ecs.hpp"
+#include "MappedScene.hpp"
+#include "NameTable.hpp"
+#include "Prefab.hpp"
+#include "SceneSnapshot.hpp"
+#include "TransformSystem.hpp"
+
+#include "BenchTiming.hpp"
+
+namespace {
+
+    using Bench::Timer;
+
+    struct Case {
+        const char* name;
+        std::function<void(std::size_t count, Timer& timer)> run;
+    };
+
+    struct Result {
+        std::string name;
+        std::size_t count;
+        double seconds;
+        int runs;
+    };
+
+    struct Options {
+        std::string out = "EngineBench.json";
+        std::string filter;
+        std::string scratch = "EngineBench.OmniScene";
+        std::vector<std::size_t> counts = {1000, 10000, 100000, 1000000};
+        double minSeconds = 0.25;
+    };
+
+    // Keeps iteration results alive so loops are not optimized away
+    volatile float sink = 0.0f;
+
+    std::vector<entt::entity> Populate(entt::registry& registry, std::size_t count) {
+        std::vector<entt::entity> entities(count);
+        registry.create(entities.begin(), entities.end());
+        registry.insert<Position>(entities.begin(), entities.end(), Position(1.0f, 2.0f, 3.0f));
+        registry.insert<Rotation>(entities.begin(), entities.end(), Rotation(0.0f, 45.0f, 0.0f));
+        registry.insert<Scale>(entities.begin(), entities.end());
+        return entities;
+    }
+
+    std::vector<Case> Cases(const Options& options) {
+        std::vector<Case> cases;
+
+        cases.push_back({"entity/create", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            timer.Start();
+            for (std::size_t i = 0; i < count; i++) static_cast<void>(registry.create());
+            timer.Stop();
+        }});
+        cases.push_back({"entity/create_bulk", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            std::vector<entt::entity> entities(count);
+            timer.Start();
+            registry.create(entities.begin(), entities.end());
+            timer.Stop();
+        }});
+        cases.push_back({"entity/destroy", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            const std::vector<entt::entity> entities = Populate(registry, count);
+            timer.Start();
+            for (const entt::entity entity : entities) registry.destroy(entity);
+            timer.Stop();
+        }});
+        cases.push_back({"entity/destroy_bulk", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            const std::vector<entt::entity> entities = Populate(registry, count);
+            timer.Start();
+            registry.destroy(entities.begin(), entities.end());
+            timer.Stop();
+        }});
+
+        cases.push_back({"component/add", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            std::vector<entt::entity> entities(count);
+            registry.create(entities.begin(), entities.end());
+            timer.Start();
+            for (const entt::entity entity : entities) registry.emplace<Position>(entity, 1.0f, 2.0f, 3.0f);
+            timer.Stop();
+        }});
+        cases.push_back({"component/add_bulk", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            std::vector<entt::entity> entities(count);
+            registry.create(entities.begin(), entities.end());
+            timer.Start();
+            registry.insert<Position>(entities.begin(), entities.end(), Position(1.0f, 2.0f, 3.0f));
+            timer.Stop();
+        }});
+        cases.push_back({"component/remove", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            const std::vector<entt::entity> entities = Populate(registry, count);
+            timer.Start();
+            for (const entt::entity entity : entities) registry.remove<Position>(entity);
+            timer.Stop();
+        }});
+        cases.push_back({"component/remove_bulk", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            const std::vector<entt::entity> entities = Populate(registry, count);
+            timer.Start();
+            registry.remove<Position>(entities.begin(), entities.end());
+            timer.Stop();
+        }});
+
+        cases.push_back({"iterate/view_one", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            Populate(registry, count);
+            timer.Start();
+            float sum = 0.0f;
+            for (auto [entity, position] : registry.view<Position>().each()) sum += position.x;
+            timer.Stop();
+            sink = sum;
+        }});
+        cases.push_back({"iterate/view_three", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            Populate(registry, count);
+            timer.Start();
+            float sum = 0.0f;
+            for (auto [entity, position, rotation, scale] : registry.view<Position, Rotation, Scale>().each()) {
+                sum += position.x + rotation.y + scale.z;
+            }
+            timer.Stop();
+            sink = sum;
+        }});
+        cases.push_back({"iterate/group_three", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            auto group = registry.group<Position, Rotation, Scale>();
+            Populate(registry, count);
+            timer.Start();
+            float sum = 0.0f;
+            for (auto [entity, position, rotation, scale] : group.each()) sum += position.x + rotation.y + scale.z;
+            timer.Stop();
+            sink = sum;
+        }});
+
+        cases.push_back({"snapshot/write", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            Populate(registry, count);
+            std::vector<unsigned char> buffer;
+            timer.Start();
+            SceneSnapshot::Write(registry, nullptr, buffer);
+            timer.Stop();
+        }});
+        cases.push_back({"snapshot/read", [](std::size_t count, Timer& timer) {
+            entt::registry source;
+            Populate(source, count);
+            std::vector<unsigned char> buffer;
+            SceneSnapshot::Write(source, nullptr, buffer);
+            entt::registry registry;
+            timer.Start();
+            SceneSnapshot::Read(registry, nullptr, buffer.data(), buffer.size());
+            timer.Stop();
+        }});
+        cases.push_back({"snapshot/save", [&options](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            Populate(registry, count);
+            timer.Start();
+            SceneSnapshot::Save(registry, nullptr, options.scratch);
+            timer.Stop();
+        }});
+        cases.push_back({"snapshot/load", [&options](std::size_t count, Timer& timer) {
+            entt::registry source;
+            Populate(source, count);
+            SceneSnapshot::Save(source, nullptr, options.scratch);
+            entt::registry registry;
+            timer.Start();
+            SceneSnapshot::Load(registry, nullptr, options.scratch);
+            timer.Stop();
+        }});
+        cases.push_back({"snapshot/load_mmap", [&options](std::size_t count, Timer& timer) {
+            entt::registry source;
+            Populate(source, count);
+            SceneSnapshot::Save(source, nullptr, options.scratch);
+            entt::registry registry;
+            timer.Start();
+            MappedScene scene;
+            if (scene.Open(options.scratch)) scene.Instantiate(registry, nullptr);
+            timer.Stop();
+        }});
+
+        cases.push_back({"prefab/instantiate", [](std::size_t count, Timer& timer) {
+            Prefab prefab;
+            prefab.With<Position>(0.0f, 1.0f, 0.0f).With<Rotation>().With<Scale>(0.1f, 0.1f, 0.1f);
+            entt::registry registry;
+            std::vector<entt::entity> entities(count);
+            timer.Start();
+            prefab.Instantiate(registry, entities.data(), entities.data() + count);
+            timer.Stop();
+        }});
+
+        cases.push_back({"transform/update", [](std::size_t count, Timer& timer) {
+            entt::registry registry;
+            TransformSystem system(registry);
+            Populate(registry, count);
+            system.Update();
+            timer.Start();
+            system.Update();
+            timer.Stop();
+        }});
+
+        return cases;
+    }
+
+    // Repeats a case until minSeconds of measured time; keeps the best run
+    Result Measure(const Case& benchCase, std::size_t count, double minSeconds) {
+        const Bench::Measurement measured = Bench::Measure([&](Timer& timer) { benchCase.run(count, timer); }, minSeconds);
+        return {benchCase.name, count, measured.seconds, measured.runs};
+    }
+
+    std::vector<std::size_t> ParseCounts(const char* text) {
+        std::vector<std::size_t> counts;
+        for (const char* cursor = text; *cursor != '\0';) {
+            char* end = nullptr;
+            const unsigned long long value = std::strtoull(cursor, &end, 10);
+            if (end == cursor) break;
+            if (value > 0) counts.push_back(static_cast<std::size_t>(value));
+            cursor = *end == ',' ? end + 1 : end;
+        }
+        return counts;
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--out") == 0 && hasValue) {
+                options.out = argv[++i];
+            } else if (std::strcmp(argv[i], "--counts") == 0 && hasValue) {
+                options.counts = ParseCounts(argv[++i]);
+            } else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) {
+                options.minSeconds = std::atof(argv[++i]);
+            } else if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+                options.filter = argv[++i];
+            } else {
+                std::fprintf(stderr, "Usage: %s [--out file.json] [--counts 1000,10000] [--min-time seconds] [--filter name]\n", argv[0]);
+                return false;
+            }
+        }
+        return !options.counts.empty();
+    }
+
+    bool WriteJson(const Options& options, const std::vector<Result>& results) {
+        std::FILE* file = std::fopen(options.out.c_str(), "w");
+        if (file == nullptr) return false;
+
+        char timestamp[32];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        std::fprintf(file, "{\n");
+        std::fprintf(file, "  \"suite\": \"EngineBench\",\n");
+        std::fprintf(file, "  \"timestamp\": \"%s\",\n", timestamp);
+#ifdef __VERSION__
+        std::fprintf(file, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+        std::fprintf(file, "  \"simd\": \"%s\",\n", TransformKernels::PathName(TransformKernels::ActivePath()));
+        std::fprintf(file, "  \"hardware_threads\": %u,\n", std::thread::hardware_concurrency());
+        std::fprintf(file, "  \"min_time_seconds\": %g,\n", options.minSeconds);
+        std::fprintf(file, "  \"results\": [\n");
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const Result& result = results[i];
+            std::fprintf(file,
+                         "    {\"name\": \"%s\", \"entities\": %zu, \"seconds\": %.9f, "
+                         "\"ns_per_entity\": %.3f, \"entities_per_second\": %.1f, \"runs\": %d}%s\n",
+                         result.name.c_str(), result.count, result.seconds,
+                         result.seconds * 1e9 / static_cast<double>(result.count),
+                         static_cast<double>(result.count) / result.seconds, result.runs,
+                         i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) return 1;
+
+    std::vector<Result> results;
+    for (const Case& benchCase : Cases(options)) {
+        if (!options.filter.empty() && std::strstr(benchCase.name, options.filter.c_str()) == nullptr) continue;
+        for (const std::size_t count : options.counts) {
+            const Result result = Measure(benchCase, count, options.minSeconds);
+            std::printf("%-22s %9zu entities %10.3f ms %9.2f ns/entity\n", result.name.c_str(), result.count,
+                        result.seconds * 1e3, result.seconds * 1e9 / static_cast<double>(result.count));
+            std::fflush(stdout);
+            results.push_back(result);
+        }
+    }
+    std::remove(options.scratch.c_str());
+
+    if (!WriteJson(options, results)) {
+        std::fprintf(stderr, "Failed to write %s\n", options.out.c_str());
+        return 1;
+    }
+    std::printf("Results written to %s\n", options.out.c_str());
+    return 0;
+}
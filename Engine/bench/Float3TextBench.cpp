@@ -0,0 +1,116 @@
+// Float3 text parsing and formatting: Float3Text (from_chars/to_chars into
+// stack buffers) against std::stof/std::to_string, in ns per value and heap
+// allocations per value.
+// Run a Release build: ./Float3TextBench
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "Float3Text.hpp"
+#include "BenchTiming.hpp"
+
+// Every heap allocation in the process goes through here
+static std::atomic<std::size_t> allocations{0};
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// The string-based path the editor used before
+static bool ParseWithStof(const std::string& value, float out[3]) {
+    std::size_t position = 0;
+    for (int i = 0; i < 3; i++) {
+        while (position < value.size() && (value[position] == ' ' || value[position] == ',')) position++;
+        std::size_t used = 0;
+        try {
+            out[i] = std::stof(value.substr(position), &used);
+        } catch (const std::exception&) {
+            return false;
+        }
+        position += used;
+    }
+    return true;
+}
+
+static std::string FormatWithToString(const float value[3]) {
+    return std::to_string(value[0]) + ", " + std::to_string(value[1]) + ", " + std::to_string(value[2]);
+}
+
+// Best ns per value of fn(), which goes over all count values
+template<typename Fn>
+static double NsPerValue(std::size_t count, Fn&& fn) {
+    return Bench::BestOf(fn) * 1e9 / count;
+}
+
+template<typename Fn>
+static double AllocationsPer(std::size_t count, Fn&& fn) {
+    const std::size_t before = allocations.load();
+    fn();
+    return static_cast<double>(allocations.load() - before) / count;
+}
+
+static void Report(const char* name, double ns, double allocs) {
+    std::printf("%-28s %9.1f ns/value %8.2f allocations/value\n", name, ns, allocs);
+}
+
+int main() {
+    const std::size_t count = 10000;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-1000.0f, 1000.0f);
+
+    std::vector<float> values(count * 3);
+    for (float& v : values) v = coord(rng);
+
+    // Inspector-style text in both the old fixed-point and the new shortest form
+    std::vector<std::string> fixedText(count);
+    std::vector<std::string> shortText(count);
+    for (std::size_t i = 0; i < count; i++) {
+        fixedText[i] = FormatWithToString(&values[i * 3]);
+        Float3Text text;
+        FormatFloat3(&values[i * 3], text);
+        shortText[i] = std::string(text.View());
+    }
+
+    float out[3];
+    float sink = 0.0f;
+    std::size_t length = 0;
+
+    auto stofFixed = [&] { for (const auto& s : fixedText) { ParseWithStof(s, out); sink += out[0]; } };
+    auto charsFixed = [&] { for (const auto& s : fixedText) { ParseFloat3(s, out); sink += out[0]; } };
+    auto stofShort = [&] { for (const auto& s : shortText) { ParseWithStof(s, out); sink += out[0]; } };
+    auto charsShort = [&] { for (const auto& s : shortText) { ParseFloat3(s, out); sink += out[0]; } };
+    Report("parse stof (fixed)", NsPerValue(count, stofFixed), AllocationsPer(count, stofFixed));
+    Report("parse from_chars (fixed)", NsPerValue(count, charsFixed), AllocationsPer(count, charsFixed));
+    Report("parse stof (shortest)", NsPerValue(count, stofShort), AllocationsPer(count, stofShort));
+    Report("parse from_chars (shortest)", NsPerValue(count, charsShort), AllocationsPer(count, charsShort));
+
+    auto toString = [&] { for (std::size_t i = 0; i < count; i++) length += FormatWithToString(&values[i * 3]).size(); };
+    auto toChars = [&] {
+        Float3Text text;
+        for (std::size_t i = 0; i < count; i++) {
+            FormatFloat3(&values[i * 3], text);
+            length += text.size;
+        }
+    };
+    Report("format to_string", NsPerValue(count, toString), AllocationsPer(count, toString));
+    Report("format to_chars", NsPerValue(count, toChars), AllocationsPer(count, toChars));
+
+    // Round trip: the shortest form must read back exactly
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        ParseFloat3(shortText[i], out);
+        if (out[0] != values[i * 3] || out[1] != values[i * 3 + 1] || out[2] != values[i * 3 + 2]) mismatches++;
+    }
+    std::printf("round-trip mismatches: %zu (checksum %g, %zu chars)\n", mismatches, sink, length);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+// RegistryMaintenance on a churned registry: iteration and neighbour-query
+// gathers before and after a Morton-order pass, pool memory before and
+// after shrinking, and what the pass costs in full and in 1 ms idle steps.
+// Run a Release build: ./MaintenanceBench
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "entt.hpp"
+#include "ecs.hpp"
+#include "RegistryMaintenance.hpp"
+#include "SpatialGrid.hpp"
+#include "BenchTiming.hpp"
+
+using Bench::Clock;
+using Bench::Seconds;
+
+// Best of five runs, in milliseconds
+template<typename Fn>
+static double BestOf(Fn&& fn) {
+    return Bench::BestOf(fn, 0.0, 5) * 1e3;
+}
+
+template<typename Component>
+static std::size_t PoolBytes(entt::registry& registry) {
+    return registry.storage<Component>().capacity() * (sizeof(Component) + sizeof(entt::entity));
+}
+
+static std::size_t SceneBytes(entt::registry& registry) {
+    return PoolBytes<Position>(registry) + PoolBytes<Transform>(registry) + PoolBytes<Rotation>(registry) +
+           PoolBytes<Scale>(registry);
+}
+
+int main() {
+    const std::size_t count = 1000000;
+    const float extent = 100.0f;
+    const int queries = 20000;
+    const float radius = 8.0f;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-extent, extent);
+
+    entt::registry registry;
+    std::vector<entt::entity> live;
+    auto spawn = [&] {
+        const entt::entity entity = registry.create();
+        registry.emplace<Position>(entity, coord(rng), coord(rng), coord(rng));
+        registry.emplace<Transform>(entity);
+        registry.emplace<Rotation>(entity, coord(rng), 0.0f, 0.0f);
+        // Not every entity is scaled, so views over all three look components up
+        if (rng() % 8 != 0) registry.emplace<Scale>(entity);
+        live.push_back(entity);
+    };
+
+    // Churn: fill up, then destroy and respawn in random order for a few rounds and drain to a third
+    for (std::size_t i = 0; i < count; i++) spawn();
+    for (int round = 0; round < 4; round++) {
+        std::shuffle(live.begin(), live.end(), rng);
+        for (std::size_t i = 0; i < count / 2; i++) registry.destroy(live[live.size() - 1 - i]);
+        live.resize(live.size() - count / 2);
+        for (std::size_t i = 0; i < count / 2; i++) spawn();
+    }
+    std::shuffle(live.begin(), live.end(), rng);
+    for (std::size_t i = count / 3; i < live.size(); i++) registry.destroy(live[i]);
+    live.resize(count / 3);
+    std::printf("%zu entities after churn\n", registry.storage<Position>().size());
+
+    std::vector<float> centers(queries * 3);
+    for (float& c : centers) c = coord(rng);
+
+    SpatialGrid grid(registry, radius);
+    float sink = 0.0f;
+    auto iterate = [&] {
+        registry.view<Position, Rotation, Scale>().each([&](const Position& p, const Rotation& r, const Scale& s) {
+            sink += p.x * s.x + r.x;
+        });
+    };
+    auto gather = [&] {
+        for (int i = 0; i < queries; i++) {
+            grid.ForEachNeighbour(&centers[i * 3], radius, [&](const SpatialGrid::Item& item) {
+                sink += registry.get<Rotation>(item.entity).x + registry.get<Transform>(item.entity).y;
+            });
+        }
+    };
+
+    grid.Rebuild();
+    const double iterateBefore = BestOf(iterate);
+    const double gatherBefore = BestOf(gather);
+    const std::size_t bytesBefore = SceneBytes(registry);
+
+    RegistryMaintenance maintenance(registry);
+    auto start = Clock::now();
+    maintenance.Run();
+    const double fullMs = Seconds(start) * 1e3;
+
+    grid.Rebuild();
+    const double iterateAfter = BestOf(iterate);
+    const double gatherAfter = BestOf(gather);
+    const std::size_t bytesAfter = SceneBytes(registry);
+
+    std::printf("%-34s %10s %10s\n", "", "before", "after");
+    std::printf("%-34s %7.2f ms %7.2f ms\n", "view<Position, Rotation, Scale>", iterateBefore, iterateAfter);
+    std::printf("%-34s %7.2f ms %7.2f ms\n", "neighbour gather (20k queries)", gatherBefore, gatherAfter);
+    std::printf("%-34s %7.1f MB %7.1f MB\n", "scene pool memory", bytesBefore / 1e6, bytesAfter / 1e6);
+    std::printf("full pass %.2f ms, %zu bytes released\n", fullMs, maintenance.ReleasedBytes());
+
+    // The same pass in idle steps, after moving everything so it has work to do
+    for (auto [entity, position] : registry.view<Position>().each()) position = Position(coord(rng), coord(rng), coord(rng));
+    maintenance.Request();
+    int steps = 0;
+    double worstMs = 0.0;
+    bool busy = true;
+    while (busy) {
+        start = Clock::now();
+        busy = maintenance.Step(1.0);
+        worstMs = std::max(worstMs, Seconds(start) * 1e3);
+        steps++;
+    }
+    std::printf("idle steps of 1 ms: %d steps, worst %.2f ms\n", steps, worstMs);
+    return sink == 12345.0f ? 1 : 0;
+}
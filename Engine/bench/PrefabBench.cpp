@@ -0,0 +1,60 @@
+// Prefab instantiation against the per-entity create + emplace path at
+// 1k, 10k, 100k and 1M copies.
+// Run a Release build: ./PrefabBench
+
+#include <cstdio>
+#include <vector>
+#include "entt.hpp"
+#include "ecs.hpp"
+#include "Prefab.hpp"
+#include "BenchTiming.hpp"
+
+// Best time of fn(registry) in seconds. The registry is cleared (not freed)
+// between runs, like a game level spawning waves.
+template<typename Fn>
+static double BestOf(Fn&& fn) {
+    entt::registry registry;
+    return Bench::Measure([&](Bench::Timer& timer) {
+        registry.clear();
+        timer.Start();
+        fn(registry);
+        timer.Stop();
+    }).seconds;
+}
+
+static void Report(const char* name, std::size_t count, double seconds) {
+    std::printf("%-16s %9zu entities %10.3f ms %10.1f M entities/s\n",
+                name, count, seconds * 1e3, count / seconds / 1e6);
+}
+
+int main() {
+    const std::size_t counts[] = {1000, 10000, 100000, 1000000};
+
+    // A bullet: placed, oriented, scaled down, with a default Transform
+    Prefab bullet;
+    bullet.With<Position>(0.0f, 1.0f, 0.0f)
+          .With<Rotation>(0.0f, 90.0f, 0.0f)
+          .With<Scale>(0.1f, 0.1f, 0.1f)
+          .With<Transform>();
+
+    for (const std::size_t count : counts) {
+        const double perEntity = BestOf([&](entt::registry& registry) {
+            for (std::size_t i = 0; i < count; i++) {
+                const entt::entity entity = registry.create();
+                registry.emplace<Position>(entity, 0.0f, 1.0f, 0.0f);
+                registry.emplace<Rotation>(entity, 0.0f, 90.0f, 0.0f);
+                registry.emplace<Scale>(entity, 0.1f, 0.1f, 0.1f);
+                registry.emplace<Transform>(entity);
+            }
+        });
+        Report("per-entity", count, perEntity);
+
+        std::vector<entt::entity> entities(count);
+        const double prefab = BestOf([&](entt::registry& registry) {
+            bullet.Instantiate(registry, entities.data(), entities.data() + count);
+        });
+        Report("prefab", count, prefab);
+        std::printf("%-16s %9zu entities %10.2fx\n", "speedup", count, perEntity / prefab);
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Save/load throughput of the binary .OmniScene snapshot at 10k, 100k and 1M
+// entities, through a buffer, stdio and a memory mapping.
+// Run a Release build: ./SnapshotBench [scratch file]
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "entt.hpp"
+#include "ecs.hpp"
+#include "MappedScene.hpp"
+#include "NameTable.hpp"
+#include "SceneSnapshot.hpp"
+#include "BenchTiming.hpp"
+
+using Bench::BestOf;
+
+static void Report(const char* name, std::size_t count, std::size_t bytes, double seconds) {
+    std::printf("%-14s %9zu entities %10.3f ms %10.1f M entities/s %9.1f MB/s\n",
+                name, count, seconds * 1e3, count / seconds / 1e6, bytes / seconds / 1e6);
+}
+
+int main(int argc, char** argv) {
+    const std::string path = argc > 1 ? argv[1] : "SnapshotBench.OmniScene";
+    const std::size_t counts[] = {10000, 100000, 1000000};
+
+    for (const std::size_t count : counts) {
+        entt::registry registry;
+        NameTable names;
+        std::vector<entt::entity> entities(count);
+        registry.create(entities.begin(), entities.end());
+        registry.insert<Position>(entities.begin(), entities.end(), Position(1.0f, 2.0f, 3.0f));
+        registry.insert<Rotation>(entities.begin(), entities.end());
+        registry.insert<Scale>(entities.begin(), entities.end());
+        registry.insert<Transform>(entities.begin(), entities.end());
+        // Every hundredth entity is named, roughly what an authored scene looks like
+        for (std::size_t i = 0; i < count; i += 100) names.Insert("Entity" + std::to_string(i), entities[i]);
+
+        std::vector<unsigned char> buffer;
+        const double write = BestOf([&] { SceneSnapshot::Write(registry, &names, buffer); });
+        Report("write", count, buffer.size(), write);
+
+        const double read = BestOf([&] {
+            entt::registry loaded;
+            NameTable loadedNames;
+            SceneSnapshot::Read(loaded, &loadedNames, buffer.data(), buffer.size());
+        });
+        Report("read", count, buffer.size(), read);
+
+        const double save = BestOf([&] { SceneSnapshot::Save(registry, &names, path); });
+        Report("save (file)", count, buffer.size(), save);
+
+        const double load = BestOf([&] {
+            entt::registry loaded;
+            NameTable loadedNames;
+            SceneSnapshot::Load(loaded, &loadedNames, path);
+        });
+        Report("load (file)", count, buffer.size(), load);
+
+        // Mapping only reads the section table, so this should stay flat as scenes grow
+        const double open = BestOf([&] {
+            MappedScene scene;
+            scene.Open(path);
+        });
+        Report("open (mmap)", count, buffer.size(), open);
+
+        const double mapped = BestOf([&] {
+            MappedScene scene;
+            entt::registry loaded;
+            NameTable loadedNames;
+            scene.Open(path);
+            scene.Instantiate(loaded, &loadedNames);
+        });
+        Report("load (mmap)", count, buffer.size(), mapped);
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
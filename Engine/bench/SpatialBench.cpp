@@ -0,0 +1,186 @@
+// SpatialTree at 1M entities: full build, per-frame refit under motion and
+// the latency distribution of box, sphere, frustum and ray queries, with a
+// brute-force scan over the registry for scale. Then SpatialGrid: the
+// per-frame rebuild, serial and on the JobSystem, and its range queries.
+// Run a Release build: ./SpatialBench
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "entt.hpp"
+#include "ecs.hpp"
+#include "ChangeTracker.hpp"
+#include "JobSystem.hpp"
+#include "SpatialGrid.hpp"
+#include "SpatialTree.hpp"
+#include "BenchTiming.hpp"
+
+using Bench::Clock;
+using Bench::Seconds;
+
+// Times each call of query(i) and prints p50/p99 in microseconds with the mean hit count
+template<typename Fn>
+static void Latency(const char* name, int queries, Fn&& query) {
+    std::vector<double> times(queries);
+    std::size_t hits = 0;
+    for (int i = 0; i < queries; i++) {
+        const auto start = Clock::now();
+        hits += query(i);
+        times[i] = Seconds(start) * 1e6;
+    }
+    std::sort(times.begin(), times.end());
+    std::printf("%-18s p50 %9.2f us  p99 %9.2f us  %8.1f hits/query\n",
+                name, times[queries / 2], times[queries * 99 / 100], static_cast<double>(hits) / queries);
+}
+
+// Column-major perspective * view for a camera at `eye` looking down -Z
+static Frustum CameraFrustum(const float eye[3]) {
+    const float fovY = 60.0f * 3.14159265f / 180.0f;
+    const float aspect = 16.0f / 9.0f;
+    const float nearPlane = 0.1f;
+    const float farPlane = 100.0f;
+    const float f = 1.0f / std::tan(fovY * 0.5f);
+
+    float m[16] = {};
+    m[0] = f / aspect;
+    m[5] = f;
+    m[10] = (farPlane + nearPlane) / (nearPlane - farPlane);
+    m[11] = -1.0f;
+    m[14] = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+    // View is a pure translation by -eye, folded into the last column
+    m[12] = -m[0] * eye[0];
+    m[13] = -m[5] * eye[1];
+    m[14] += -m[10] * eye[2];
+    m[15] = eye[2];
+    return Frustum::FromMatrix(m);
+}
+
+int main() {
+    const std::size_t count = 1000000;
+    const float extent = 500.0f;
+    const int queries = 10000;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-extent, extent);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> size(0.5f, 2.0f);
+    std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    entt::registry registry;
+    std::vector<entt::entity> entities(count);
+    registry.create(entities.begin(), entities.end());
+    for (const entt::entity entity : entities) {
+        registry.emplace<Position>(entity, coord(rng), coord(rng), coord(rng));
+        registry.emplace<Scale>(entity, size(rng), size(rng), size(rng));
+    }
+    // Half of them rotated
+    for (std::size_t i = 0; i < count; i += 2) {
+        registry.emplace<Rotation>(entities[i], angle(rng), angle(rng), angle(rng));
+    }
+
+    JobSystem jobs;
+    ChangeTracker tracker(registry);
+    tracker.Track<Position>();
+    tracker.Track<Rotation>();
+    tracker.Track<Scale>();
+
+    auto start = Clock::now();
+    SpatialTree tree(registry, &jobs);
+    std::printf("build              %9zu entities %10.3f ms  height %d\n", tree.Size(), Seconds(start) * 1e3, tree.Height());
+
+    // Frames where 1% of entities drift a little and 0.1% teleport
+    const int frames = 60;
+    double refitTotal = 0.0;
+    double refitWorst = 0.0;
+    for (int frame = 0; frame < frames; frame++) {
+        const std::uint64_t since = tracker.Frame() - 1;
+        for (std::size_t i = 0; i < count / 100; i++) {
+            const entt::entity entity = entities[rng() % count];
+            registry.patch<Position>(entity, [&](Position& p) {
+                p.x += jitter(rng);
+                p.y += jitter(rng);
+                p.z += jitter(rng);
+            });
+        }
+        for (std::size_t i = 0; i < count / 1000; i++) {
+            registry.replace<Position>(entities[rng() % count], coord(rng), coord(rng), coord(rng));
+        }
+
+        start = Clock::now();
+        tree.Update(tracker, since);
+        const double elapsed = Seconds(start);
+        refitTotal += elapsed;
+        refitWorst = std::max(refitWorst, elapsed);
+        tracker.NextFrame();
+        tracker.Trim(tracker.Frame() - 1);
+    }
+    std::printf("refit (11k moved)  avg %9.3f ms  worst %7.3f ms  quality %.2f%s\n",
+                refitTotal / frames * 1e3, refitWorst * 1e3, tree.Quality(), tree.Rebuilding() ? "  (rebuilding)" : "");
+
+    std::vector<entt::entity> out;
+    std::vector<float> centers(queries * 3);
+    for (float& c : centers) c = coord(rng);
+
+    Latency("box (20^3)", queries, [&](int i) {
+        const float* c = &centers[i * 3];
+        out.clear();
+        tree.QueryBox({{c[0] - 10.0f, c[1] - 10.0f, c[2] - 10.0f}, {c[0] + 10.0f, c[1] + 10.0f, c[2] + 10.0f}}, out);
+        return out.size();
+    });
+    Latency("sphere (r 10)", queries, [&](int i) {
+        out.clear();
+        tree.QuerySphere(&centers[i * 3], 10.0f, out);
+        return out.size();
+    });
+    Latency("frustum (far 100)", queries / 10, [&](int i) {
+        out.clear();
+        tree.QueryFrustum(CameraFrustum(&centers[i * 3]), out);
+        return out.size();
+    });
+    Latency("raycast", queries, [&](int i) {
+        Ray ray = {{centers[i * 3], centers[i * 3 + 1], centers[i * 3 + 2]}, {unit(rng), unit(rng), unit(rng)}, 1000.0f};
+        const float length = std::sqrt(ray.direction[0] * ray.direction[0] + ray.direction[1] * ray.direction[1] +
+                                       ray.direction[2] * ray.direction[2]);
+        for (float& d : ray.direction) d /= length;
+        entt::entity hit;
+        float distance;
+        return static_cast<std::size_t>(tree.Raycast(ray, hit, distance));
+    });
+
+    // The same box query as a linear scan, for comparison
+    auto view = registry.view<Position, Scale>();
+    Latency("box brute force", 20, [&](int i) {
+        const float* c = &centers[i * 3];
+        const Aabb box = {{c[0] - 10.0f, c[1] - 10.0f, c[2] - 10.0f}, {c[0] + 10.0f, c[1] + 10.0f, c[2] + 10.0f}};
+        out.clear();
+        for (const entt::entity entity : view) {
+            if (Overlaps(EntityBounds(view.get<Position>(entity), registry.try_get<Rotation>(entity), view.get<Scale>(entity)), box)) {
+                out.push_back(entity);
+            }
+        }
+        return out.size();
+    });
+
+    // Grid with cells the size of the query radius
+    SpatialGrid grid(registry, 10.0f);
+    for (JobSystem* pool : {static_cast<JobSystem*>(nullptr), &jobs}) {
+        const double best = Bench::BestOf([&] { grid.Rebuild(pool); }, 0.0, 10);
+        std::printf("grid rebuild %-5s %9zu entities %10.3f ms\n", pool == nullptr ? "1T" : "jobs", grid.Size(), best * 1e3);
+    }
+    Latency("grid box (20^3)", queries, [&](int i) {
+        const float* c = &centers[i * 3];
+        out.clear();
+        grid.QueryBox({{c[0] - 10.0f, c[1] - 10.0f, c[2] - 10.0f}, {c[0] + 10.0f, c[1] + 10.0f, c[2] + 10.0f}}, out);
+        return out.size();
+    });
+    Latency("grid radius (10)", queries, [&](int i) {
+        out.clear();
+        grid.QueryRadius(&centers[i * 3], 10.0f, out);
+        return out.size();
+    });
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+// Status logging with 1, 4 and 16 producer threads: the lock-free queue
+// against the mutex-guarded vector it replaced. Frame-paced bursts give the
+// cost of a Set call; logging flat out gives the saturated throughput. The
+// consumer drains once per 16 ms frame in both. Then a message with an
+// argument built eagerly against Status::Log(), which defers formatting, and
+// the cost of keeping a long session's history: the unbounded vector against
+// the bounded ring.
+// Run a Release build: ./StatusBench
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Status.hpp"
+#include "BenchTiming.hpp"
+
+using Bench::Clock;
+using Bench::Seconds;
+
+namespace {
+
+    // The previous implementation: every call takes one global lock
+    namespace Locked {
+        struct LogEntry {
+            Status::LogType type;
+            std::string message;
+        };
+
+        std::mutex mutex;
+        std::string runtimeStatus;
+        std::vector<LogEntry> history;
+
+        void SetRuntimeStatus(const std::string& s) {
+            std::lock_guard<std::mutex> lock(mutex);
+            runtimeStatus = s;
+            history.push_back({Status::LogType::Runtime, s});
+        }
+
+        void Drain() {
+            std::lock_guard<std::mutex> lock(mutex);
+            history.clear();
+        }
+    }
+
+    // Heap bytes held by the vector history: entries plus out-of-line strings
+    std::size_t VectorBytes(const std::vector<Locked::LogEntry>& history) {
+        std::size_t bytes = history.capacity() * sizeof(Locked::LogEntry);
+        for (const Locked::LogEntry& entry : history) {
+            if (entry.message.capacity() > 15) bytes += entry.message.capacity() + 1;
+        }
+        return bytes;
+    }
+
+    template<typename Fn>
+    double Milliseconds(Fn&& fn) {
+        const auto start = Clock::now();
+        fn();
+        return Seconds(start) * 1e3;
+    }
+
+    // Frame-paced logging: every 16 ms the consumer drains, then each
+    // producer logs its share of `perFrame` entries. Returns ns per Set call,
+    // timing only the calls.
+    template<typename SetFn, typename DrainFn>
+    double Paced(std::size_t producers, std::size_t perFrame, int frames, SetFn&& set, DrainFn&& drain) {
+        std::atomic<int> frame{0};
+        std::atomic<std::size_t> finished{0};
+        std::vector<double> seconds(producers, 0.0);
+        const std::size_t share = perFrame / producers;
+
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; p++) {
+            threads.emplace_back([&, p] {
+                const std::string message = "Entity " + std::to_string(1000 + p) + " created";
+                for (int f = 1; f <= frames; f++) {
+                    while (frame.load(std::memory_order_acquire) < f) std::this_thread::yield();
+                    const auto start = Clock::now();
+                    for (std::size_t i = 0; i < share; i++) set(message);
+                    seconds[p] += Seconds(start);
+                    finished.fetch_add(1, std::memory_order_release);
+                }
+            });
+        }
+        for (int f = 1; f <= frames; f++) {
+            drain();
+            frame.store(f, std::memory_order_release);
+            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            while (finished.load(std::memory_order_acquire) < producers * f) std::this_thread::yield();
+        }
+        for (std::thread& thread : threads) thread.join();
+        drain();
+
+        double total = 0.0;
+        for (const double s : seconds) total += s;
+        return total * 1e9 / (share * producers * frames);
+    }
+
+    // Producers log flat out while the consumer still drains only once per
+    // frame, so the queue is full most of the time. Returns entries per second.
+    template<typename SetFn, typename DrainFn>
+    double Saturated(std::size_t producers, std::size_t perThread, SetFn&& set, DrainFn&& drain) {
+        std::atomic<bool> done{false};
+        std::thread consumer([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                drain();
+                std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            }
+        });
+
+        const auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; p++) {
+            threads.emplace_back([&, p] {
+                const std::string message = "Entity " + std::to_string(1000 + p) + " created";
+                for (std::size_t i = 0; i < perThread; i++) set(message);
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        const double wall = Seconds(start);
+        done.store(true, std::memory_order_release);
+        consumer.join();
+        drain();
+        return producers * perThread / wall;
+    }
+}
+
+int main() {
+    const std::size_t perFrame = 2048;
+    const int frames = 60;
+    const std::size_t total = 1600000;
+
+    auto lockedSet = [](const std::string& s) { Locked::SetRuntimeStatus(s); };
+    auto lockedDrain = [] { Locked::Drain(); };
+    auto queuedSet = [](const std::string& s) { Status::SetRuntimeStatus(s); };
+    auto queuedDrain = [] { Status::ClearAllLogs(); };
+
+    std::printf("%zu entries per 16 ms frame, drained once per frame\n", perFrame);
+    std::printf("%-10s %14s %14s\n", "producers", "mutex ns/call", "queue ns/call");
+    for (const std::size_t producers : {1, 4, 16}) {
+        const double locked = Paced(producers, perFrame, frames, lockedSet, lockedDrain);
+        const double queued = Paced(producers, perFrame, frames, queuedSet, queuedDrain);
+        std::printf("%-10zu %14.1f %14.1f\n", producers, locked, queued);
+    }
+
+    std::printf("\nsaturated, %zu entries in total\n", total);
+    std::printf("%-10s %16s %16s\n", "producers", "mutex entries/s", "queue entries/s");
+    for (const std::size_t producers : {1, 4, 16}) {
+        const double locked = Saturated(producers, total / producers, lockedSet, lockedDrain);
+        const double queued = Saturated(producers, total / producers, queuedSet, queuedDrain);
+        std::printf("%-10zu %16.0f %16.0f\n", producers, locked, queued);
+    }
+
+    // "Entity <id> created": string building at the call site against a deferred record
+    auto eagerSet = [](const std::string&) {
+        thread_local std::uint64_t id = 0;
+        Status::SetRuntimeStatus("Entity " + std::to_string(id++) + " created");
+    };
+    auto deferredSet = [](const std::string&) {
+        thread_local std::uint64_t id = 0;
+        Status::Log(Status::LogType::Runtime, "Entity {} created", id++);
+    };
+    std::printf("\nmessage with one argument, %zu entries per 16 ms frame\n", perFrame);
+    std::printf("%-10s %14s %14s\n", "producers", "eager ns/call", "Log ns/call");
+    for (const std::size_t producers : {1, 4, 16}) {
+        const double eager = Paced(producers, perFrame, frames, eagerSet, queuedDrain);
+        const double deferred = Paced(producers, perFrame, frames, deferredSet, queuedDrain);
+        std::printf("%-10zu %14.1f %14.1f\n", producers, eager, deferred);
+    }
+
+    // A session's worth of runtime messages kept in both histories
+    const std::size_t session = 2000000;
+    std::vector<Locked::LogEntry> vectorHistory;
+    Status::LogHistory ringHistory;
+    std::string message;
+    const double vectorPush = Milliseconds([&] {
+        for (std::size_t i = 0; i < session; i++) {
+            message = "Entity " + std::to_string(i) + " moved to the streaming cell";
+            vectorHistory.push_back({Status::LogType::Runtime, message});
+        }
+    });
+    const double ringPush = Milliseconds([&] {
+        for (std::size_t i = 0; i < session; i++) {
+            message = "Entity " + std::to_string(i) + " moved to the streaming cell";
+            ringHistory.Push(Status::LogType::Runtime, message);
+        }
+    });
+    std::size_t sink = 0;
+    const double vectorIterate = Milliseconds([&] {
+        for (const Locked::LogEntry& entry : vectorHistory) sink += entry.message.size() + static_cast<std::size_t>(entry.type);
+    });
+    const double ringIterate = Milliseconds([&] {
+        for (const Status::LogEntry entry : ringHistory) sink += entry.message.size() + static_cast<std::size_t>(entry.type);
+    });
+
+    std::printf("\nhistory after %zu entries\n", session);
+    std::printf("%-8s %10s %10s %12s %14s\n", "", "entries", "memory", "push ns", "iterate ns");
+    std::printf("%-8s %10zu %7.1f MB %12.1f %14.2f\n", "vector", vectorHistory.size(), VectorBytes(vectorHistory) / 1e6,
+                vectorPush * 1e6 / session, vectorIterate * 1e6 / vectorHistory.size());
+    std::printf("%-8s %10zu %7.1f MB %12.1f %14.2f  (%llu dropped)\n", "ring", ringHistory.Size(), ringHistory.MemoryBytes() / 1e6,
+                ringPush * 1e6 / session, ringIterate * 1e6 / ringHistory.Size(),
+                static_cast<unsigned long long>(ringHistory.Dropped()));
+    return sink == 1 ? 1 : 0;
+}
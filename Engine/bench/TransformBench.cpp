@@ -0,0 +1,57 @@
+// Throughput of the world-matrix kernels at 10k, 100k and 1M entities.
+// Run a Release build: ./TransformBench
+
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "entt.hpp"
+#include "ecs.hpp"
+#include "TransformSystem.hpp"
+#include "BenchTiming.hpp"
+
+using Bench::BestOf;
+
+static void Report(const char* name, std::size_t count, double seconds) {
+    std::printf("%-22s %9zu entities %10.3f ms %12.1f M matrices/s\n",
+                name, count, seconds * 1e3, count / seconds / 1e6);
+}
+
+int main() {
+    const std::size_t counts[] = {10000, 100000, 1000000};
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+
+    std::printf("Active kernel: %s\n", TransformKernels::PathName(TransformKernels::ActivePath()));
+
+    for (const std::size_t count : counts) {
+        entt::registry registry;
+        TransformSystem system(registry);
+
+        std::vector<entt::entity> entities(count);
+        registry.create(entities.begin(), entities.end());
+
+        std::vector<Position> positions(count);
+        std::vector<Rotation> rotations(count);
+        std::vector<Scale> scales(count);
+        for (std::size_t i = 0; i < count; i++) {
+            positions[i] = Position(coord(rng), coord(rng), coord(rng));
+            rotations[i] = Rotation(angle(rng), angle(rng), angle(rng));
+            scales[i] = Scale(1.0f, 2.0f, 0.5f);
+        }
+        registry.insert<Position>(entities.begin(), entities.end(), positions.begin());
+        registry.insert<Rotation>(entities.begin(), entities.end(), rotations.begin());
+        registry.insert<Scale>(entities.begin(), entities.end(), scales.begin());
+
+        std::vector<WorldMatrix> out(count);
+        Report("scalar kernel", count, BestOf([&] {
+            TransformKernels::ComputeScalar(positions.data(), rotations.data(), scales.data(), count, out.data());
+        }));
+        Report("simd kernel", count, BestOf([&] {
+            TransformKernels::Compute(positions.data(), rotations.data(), scales.data(), count, out.data());
+        }));
+        Report("TransformSystem", count, BestOf([&] { system.Update(); }));
+    }
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+// omnix-headless: steps a scene's engine systems without a window, GLFW or
+// an OpenGL context, for batch simulation on servers. Links only the Engine
+// library.
+//
+//   ./omnix-headless [--project name | --scene file.OmniScene] [--spawn count]
+//                    [--ticks 1000] [--rate 0] [--worlds 1] [--profile out.json]
+//
+// --rate 0 steps as fast as possible; any other value paces ticks at that many
+// per second. --worlds simulates independent copies of the scene on separate
+// threads. Prints ticks per second, tick time percentiles and the first
+// world's per-system timings.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "entt.hpp"
+#include "ChangeTracker.hpp"
+#include "ecs.hpp"
+#include "EngineInit.hpp"
+#include "JobSystem.hpp"
+#include "Scheduler.hpp"
+#include "SpatialGrid.hpp"
+#include "Status.hpp"
+#include "SystemProfiler.hpp"
+#include "TransformSystem.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    struct Options {
+        std::string scene;
+        std::size_t spawn = 0;
+        std::uint64_t ticks = 1000;
+        double rate = 0.0;
+        std::size_t worlds = 1;
+        std::string profile;
+    };
+
+    struct WorldReport {
+        bool loaded = false;
+        std::size_t entities = 0;
+        std::size_t threads = 0;
+        double seconds = 0.0;
+        std::vector<double> tickMilliseconds;
+        std::vector<SystemProfiler::Stats> systems;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--project") == 0 && hasValue) {
+                options.scene = EngineInit().ProjectPath(argv[++i]) + "/Scenes/Default.OmniScene";
+            } else if (std::strcmp(argv[i], "--scene") == 0 && hasValue) {
+                options.scene = argv[++i];
+            } else if (std::strcmp(argv[i], "--spawn") == 0 && hasValue) {
+                options.spawn = std::strtoull(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--ticks") == 0 && hasValue) {
+                options.ticks = std::strtoull(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) {
+                options.rate = std::atof(argv[++i]);
+            } else if (std::strcmp(argv[i], "--worlds") == 0 && hasValue) {
+                options.worlds = std::max<std::size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+            } else if (std::strcmp(argv[i], "--profile") == 0 && hasValue) {
+                options.profile = argv[++i];
+            } else {
+                std::fprintf(stderr,
+                             "Usage: %s [--project name | --scene file.OmniScene] [--spawn count] [--ticks 1000]\n"
+                             "       [--rate ticks-per-second, 0 = unpaced] [--worlds 1] [--profile out.json]\n",
+                             argv[0]);
+                return false;
+            }
+        }
+        if (options.scene.empty() && options.spawn == 0) {
+            std::fprintf(stderr, "Nothing to simulate: pass --project, --scene or --spawn\n");
+            return false;
+        }
+        return true;
+    }
+
+    // Unnamed entities on a lattice two units apart, so the spatial grid has work to do
+    void Spawn(ECS& ecs, std::size_t count) {
+        const std::vector<entt::entity> entities = ecs.CreateEntities(count);
+        const auto side = static_cast<std::size_t>(std::ceil(std::cbrt(static_cast<double>(count))));
+        auto& positions = ecs.Registry().storage<Position>();
+        for (std::size_t i = 0; i < entities.size(); i++) {
+            positions.get(entities[i]) = Position(2.0f * (i % side), 2.0f * (i / side % side), 2.0f * (i / side / side));
+        }
+    }
+
+    void RunWorld(const Options& options, std::size_t workers, bool exportProfile, WorldReport& report) {
+        // Each world needs its own pool, see Scheduler
+        JobSystem jobs(workers);
+        report.threads = jobs.ThreadCount();
+        ECS ecs;
+        if (!options.scene.empty() && !ecs.LoadScene(options.scene)) return;
+        if (options.spawn != 0) Spawn(ecs, options.spawn);
+        report.loaded = true;
+        report.entities = ecs.Registry().storage<Position>().size();
+
+        // The editor's per-tick systems. Matrices are only rewritten for
+        // entities whose components changed since the previous tick.
+        TransformSystem transforms(ecs.Registry());
+        ChangeTracker changes(ecs.Registry());
+        changes.Track<Position>();
+        changes.Track<Rotation>();
+        changes.Track<Scale>();
+        std::uint64_t consumed = 0;
+        Scheduler scheduler(ecs.Registry(), jobs, &ecs.Profiler());
+        scheduler.AddSystem<Reads<Position, Rotation, Scale>>("Transforms", [&](SystemContext& context) {
+            transforms.Update(changes, consumed);
+            // Edits later in this tick (command playback) are stamped with the
+            // current frame too, so the next tick reads that frame again
+            consumed = changes.Frame() - 1;
+            context.CountVisited(transforms.FullRebuild() ? transforms.Size() : transforms.UpdatedIndices().size());
+        });
+        scheduler.AddSystem<Reads<Position>>("SpatialGrid", [&ecs](SystemContext& context) {
+            ecs.Grid().Rebuild(&context.Jobs());
+            context.CountVisited(ecs.Grid().Size());
+        });
+
+        const auto step = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(options.rate > 0.0 ? 1.0 / options.rate : 0.0));
+        report.tickMilliseconds.reserve(options.ticks);
+        const auto start = Clock::now();
+        auto next = start;
+        for (std::uint64_t tick = 0; tick < options.ticks; tick++) {
+            const auto tickStart = Clock::now();
+            scheduler.Run();
+            report.tickMilliseconds.push_back(std::chrono::duration<double, std::milli>(Clock::now() - tickStart).count());
+            // The profiler ring is bounded, so drain it as the editor does every frame
+            ecs.Profiler().Drain();
+            // So is the change log, once nothing will read the frames it forgets
+            changes.Trim(consumed);
+            changes.NextFrame();
+            if (options.rate > 0.0) {
+                next += step;
+                std::this_thread::sleep_until(next);
+            }
+        }
+        report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        report.systems = ecs.Profiler().Systems();
+        if (exportProfile) ecs.Profiler().ExportJson(options.profile);
+    }
+
+    double Percentile(std::vector<double> values, double fraction) {
+        if (values.empty()) return 0.0;
+        const auto index = static_cast<std::size_t>(fraction * (values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) return 1;
+
+    // Cores are split between the worlds; each world thread runs jobs too
+    const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    const std::size_t workers = options.worlds == 1 ? JobSystem::DefaultWorkerCount()
+                                                    : std::max<std::size_t>(1, hardware / options.worlds) - 1;
+    std::vector<WorldReport> reports(options.worlds);
+    const auto start = Clock::now();
+    if (options.worlds == 1) {
+        RunWorld(options, workers, !options.profile.empty(), reports[0]);
+    } else {
+        std::vector<std::thread> threads;
+        for (std::size_t w = 0; w < options.worlds; w++) {
+            threads.emplace_back([&, w] { RunWorld(options, workers, w == 0 && !options.profile.empty(), reports[w]); });
+        }
+        for (std::thread& thread : threads) thread.join();
+    }
+    const double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (const WorldReport& report : reports) {
+        if (!report.loaded) {
+            std::fprintf(stderr, "Failed to load %s: %s\n", options.scene.c_str(), Status::GetError().c_str());
+            return 1;
+        }
+    }
+
+    std::printf("%zu world(s), %zu entities each, %llu ticks, %zu threads per world, ", options.worlds,
+                reports[0].entities, static_cast<unsigned long long>(options.ticks), reports[0].threads);
+    if (options.rate > 0.0) {
+        std::printf("paced at %g Hz\n", options.rate);
+    } else {
+        std::printf("unpaced\n");
+    }
+    for (std::size_t w = 0; w < reports.size(); w++) {
+        const WorldReport& report = reports[w];
+        std::printf("world %zu: %10.1f ticks/s  p50 %8.3f ms  p99 %8.3f ms  max %8.3f ms\n", w,
+                    report.seconds > 0.0 ? options.ticks / report.seconds : 0.0, Percentile(report.tickMilliseconds, 0.5),
+                    Percentile(report.tickMilliseconds, 0.99), Percentile(report.tickMilliseconds, 1.0));
+    }
+    std::printf("total:   %10.1f ticks/s over %.3f s\n", options.ticks * options.worlds / wallSeconds, wallSeconds);
+
+    std::printf("\n%-16s %10s %10s %10s %12s\n", "system", "mean ms", "max ms", "runs", "entities");
+    for (const SystemProfiler::Stats& stats : reports[0].systems) {
+        std::printf("%-16s %10.3f %10.3f %10llu %12llu\n", stats.name.c_str(), stats.MeanMilliseconds(),
+                    stats.maxNanoseconds / 1e6, static_cast<unsigned long long>(stats.runs),
+                    static_cast<unsigned long long>(stats.lastEntities));
+    }
+    return 0;
+}
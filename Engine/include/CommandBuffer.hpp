@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "entt.hpp"
+
+// Placeholder for an entity created through a CommandBuffer. Only valid in
+// the buffer that returned it, until that buffer is played back.
+struct DeferredEntity {
+    std::uint32_t index;
+};
+
+// Records structural changes (create, destroy, add, remove) for later
+// playback on the owning thread. Recording never touches the registry, so
+// worker threads can each fill their own buffer without locking.
+class CommandBuffer {
+public:
+    CommandBuffer() = default;
+    ~CommandBuffer();
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    // Commands recorded from here on are merged by key at playback.
+    // Returns the previous key so nested producers can restore it.
+    std::uint64_t BeginBatch(std::uint64_t key);
+
+    DeferredEntity Create();
+    void Destroy(entt::entity entity);
+    void Destroy(DeferredEntity entity);
+
+    template<typename Component, typename... Args>
+    void Add(entt::entity entity, Args&&... args) {
+        RecordAdd<Component>(entity, noDeferred, std::forward<Args>(args)...);
+    }
+
+    template<typename Component, typename... Args>
+    void Add(DeferredEntity entity, Args&&... args) {
+        RecordAdd<Component>(entt::null, entity.index, std::forward<Args>(args)...);
+    }
+
+    template<typename Component>
+    void Remove(entt::entity entity) { RecordRemove<Component>(entity, noDeferred); }
+
+    template<typename Component>
+    void Remove(DeferredEntity entity) { RecordRemove<Component>(entt::null, entity.index); }
+
+    bool Empty() const { return commands.empty(); }
+    std::size_t Size() const { return commands.size(); }
+
+    // Applies this buffer on its own, in record order, then clears it
+    void Playback(entt::registry& registry);
+    // Drops all recorded commands but keeps the allocated memory
+    void Clear();
+
+private:
+    friend class CommandQueue;
+
+    static constexpr std::uint32_t noDeferred = 0xFFFFFFFFu;
+    static constexpr std::size_t blockSize = 64 * 1024;
+
+    enum class Op : std::uint8_t { Create, Destroy, Add, Remove };
+    using ApplyFn = void (*)(entt::registry&, entt::entity, void*);
+    using DestroyFn = void (*)(void*);
+
+    struct Command {
+        Op op;
+        std::uint32_t deferred;
+        entt::entity entity;
+        ApplyFn apply;
+        DestroyFn destroy;
+        void* payload;
+    };
+
+    struct Batch {
+        std::uint64_t key;
+        std::size_t first;
+    };
+
+    template<typename Component, typename... Args>
+    void RecordAdd(entt::entity entity, std::uint32_t deferred, Args&&... args) {
+        void* payload = Allocate(sizeof(Component), alignof(Component));
+        new (payload) Component(std::forward<Args>(args)...);
+        Record({Op::Add, deferred, entity,
+                [](entt::registry& registry, entt::entity target, void* data) {
+                    registry.emplace_or_replace<Component>(target, std::move(*static_cast<Component*>(data)));
+                },
+                [](void* data) { static_cast<Component*>(data)->~Component(); },
+                payload});
+    }
+
+    template<typename Component>
+    void RecordRemove(entt::entity entity, std::uint32_t deferred) {
+        Record({Op::Remove, deferred, entity,
+                [](entt::registry& registry, entt::entity target, void*) { registry.remove<Component>(target); },
+                nullptr, nullptr});
+    }
+
+    void Record(const Command& command);
+    void* Allocate(std::size_t size, std::size_t align);
+    std::size_t BatchEnd(std::size_t batch) const;
+    entt::entity Resolve(const Command& command) const;
+    static void Apply(entt::registry& registry, const Command& command, entt::entity target);
+
+    std::vector<Command> commands;
+    std::vector<Batch> batches;
+    std::uint64_t currentKey = 0;
+    std::uint32_t createCount = 0;
+    std::vector<entt::entity> resolved;
+
+    std::vector<std::unique_ptr<unsigned char[]>> blocks;
+    std::vector<std::size_t> blockSizes;
+    std::size_t blockIndex = 0;
+    std::size_t blockUsed = 0;
+};
+
+// One CommandBuffer per JobSystem thread, merged at a sync point.
+// Batches from all buffers are applied in ascending key order; within a key,
+// buffers are taken in thread order. Producers that need a reproducible
+// result across runs give independent work distinct keys.
+class CommandQueue {
+public:
+    explicit CommandQueue(std::size_t threadCount);
+
+    // Buffer of the calling JobSystem thread (see JobSystem::CurrentWorker)
+    CommandBuffer& Local();
+    CommandBuffer& Buffer(std::size_t thread) { return *buffers[thread]; }
+    std::size_t BufferCount() const { return buffers.size(); }
+
+    bool Empty() const;
+    // Applies and clears every buffer; created entities are allocated in one range
+    void Playback(entt::registry& registry);
+
+private:
+    std::vector<std::unique_ptr<CommandBuffer>> buffers;
+};
@@ -6,6 +6,9 @@
 class EngineInit {
 public:
     void Init(int StartEngineMode = 1, std::string ProjectName = "None", bool NewProject = true); 
+
+    // Directory a project lives in, e.g. ProjectPath(name) + "/Scenes/Default.OmniScene"
+    std::string ProjectPath(const std::string& ProjectName) const;
 };
 
 namespace fs = std::filesystem;
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// Text form of Position/Rotation/Scale-style values, "x, y, z", for the
+// Inspector and text scene formats. Nothing here touches the heap: parsing
+// reads the string_view in place and formatting writes into a fixed buffer.
+
+// Holds one formatted value; large enough for three floats in any form
+struct Float3Text {
+    static constexpr std::size_t capacity = 64;
+    char data[capacity];
+    std::size_t size = 0;
+
+    std::string_view View() const { return {data, size}; }
+};
+
+// Accepts "x y z" or "x, y, z": any run of spaces, tabs and commas separates
+// the numbers; surrounding whitespace is ignored, anything else fails
+bool ParseFloat3(std::string_view text, float out[3]);
+
+// Shortest text that parses back to the same three floats
+void FormatFloat3(const float value[3], Float3Text& out);
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "entt.hpp"
+#include "NameTable.hpp"
+#include "SceneSnapshot.hpp"
+
+// Entity and component arrays of one storage, pointing into the mapping
+template<typename Component>
+struct MappedArray {
+    const entt::entity* entities = nullptr;
+    const Component* components = nullptr;
+    std::size_t size = 0;
+};
+
+// Read-only memory mapping of a .OmniScene file.
+// Open() maps the file and reads the section table only; the arrays are
+// faulted in by the kernel when first touched, so opening a multi-GB scene
+// costs about the same as opening an empty one and adds no resident memory.
+class MappedScene {
+public:
+    MappedScene() = default;
+    ~MappedScene() { Close(); }
+
+    MappedScene(const MappedScene&) = delete;
+    MappedScene& operator=(const MappedScene&) = delete;
+    MappedScene(MappedScene&& other) noexcept;
+    MappedScene& operator=(MappedScene&& other) noexcept;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return open; }
+    std::size_t Size() const { return size; }
+    const std::vector<SceneSnapshot::Section>& Sections() const { return sections; }
+
+    // Zero-copy access to a stored component array; empty if the scene has none
+    template<typename Component>
+    MappedArray<Component> Components() const {
+        for (const SceneSnapshot::Section& section : sections) {
+            if (section.header.id != SceneSnapshot::SectionId<Component>()) continue;
+            if (section.header.elementSize != sizeof(Component)) break;
+            return {reinterpret_cast<const entt::entity*>(section.entities),
+                    reinterpret_cast<const Component*>(section.payload), section.header.count};
+        }
+        return {};
+    }
+
+    // Builds registry storages straight from the mapped arrays (registry must be empty)
+    bool Instantiate(entt::registry& registry, NameTable* names) const;
+
+private:
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+    bool open = false;
+    std::vector<SceneSnapshot::Section> sections;
+};
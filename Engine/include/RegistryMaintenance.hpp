@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "entt.hpp"
+#include "ecs.hpp"
+
+// Idle-time housekeeping for a registry after create/destroy churn.
+//
+// A pass sorts the Position pool by the Morton code of each position, so
+// entities that are close in space are close in memory, makes the other
+// scene component pools follow that order, then gives back the memory of
+// pools that have drained well below their capacity. The work is cut into
+// small resumable steps and Step() runs as many as fit into its budget; a
+// component added or removed in between restarts the sort.
+//
+// When Position, Rotation and Scale are owned by the TransformSystem group
+// the three pools are swapped together, so the group stays valid.
+// Reordering moves entities to other pool indices: anything caching them
+// (TransformSystem::Invalidate()) should watch Generation().
+class RegistryMaintenance {
+public:
+    explicit RegistryMaintenance(entt::registry& registry);
+
+    RegistryMaintenance(const RegistryMaintenance&) = delete;
+    RegistryMaintenance& operator=(const RegistryMaintenance&) = delete;
+
+    // Runs steps until budgetMs is spent. A pass starts by itself once an
+    // eighth of the Positions were created or destroyed since the last one,
+    // or after Request(). Returns true while a pass is still in progress.
+    bool Step(double budgetMs = 1.0);
+    // A whole pass right away, whatever it costs (benchmarks, before saving)
+    void Run();
+    // Starts a pass on the next Step() even without churn, e.g. after large moves
+    void Request() { requested = true; }
+
+    // Bumped by every step that moved entities within a pool
+    std::uint64_t Generation() const { return generation; }
+    std::uint64_t Passes() const { return passes; }
+    // Memory handed back by shrinking drained pools, over all passes
+    std::size_t ReleasedBytes() const { return releasedBytes; }
+
+private:
+    enum class Phase { Idle, Bounds, Keys, Sort, Arrange, Follow, Shrink };
+
+    // Entities per step in the linear phases
+    static constexpr std::size_t chunk = 4096;
+    static constexpr int radixBits = 8;
+    static constexpr int radixPasses = 4;
+    static constexpr std::size_t buckets = std::size_t{1} << radixBits;
+
+    // One unit of work; false when idle with nothing to do
+    bool Advance();
+    void Begin();
+    void StepBounds();
+    void StepKeys();
+    void StepSort();
+    void StepArrange();
+    void StepFollow();
+    void StepShrink();
+    template<typename Component>
+    void Shrink();
+
+    void OnPositionChange(entt::registry&, entt::entity);
+    void OnStructureChange(entt::registry&, entt::entity) { structureChanged = true; }
+
+    entt::registry& registry;
+    std::vector<entt::scoped_connection> connections;
+
+    Phase phase = Phase::Idle;
+    std::size_t cursor = 0;
+    std::size_t churn = 0;
+    bool requested = false;
+    bool structureChanged = false;
+
+    // Snapshot of the Position pool the current pass works on
+    std::size_t count = 0;
+    std::size_t groupSize = 0;
+    bool grouped = false;
+    float low[3];
+    float high[3];
+
+    // Morton keys sorted together with their entities, LSD radix
+    std::vector<std::uint32_t> keys;
+    std::vector<std::uint32_t> scratchKeys;
+    std::vector<entt::entity> order;
+    std::vector<entt::entity> scratchOrder;
+    std::size_t histogram[radixPasses][buckets];
+    std::size_t offsets[buckets];
+    int radixPass = 0;
+
+    // Pools that take Position's order in the Follow phase, with the next index to fill
+    struct Follower {
+        entt::sparse_set* pool;
+        std::size_t next;
+    };
+    Follower follow[3];
+    std::size_t followers = 0;
+
+    std::uint64_t generation = 0;
+    std::uint64_t passes = 0;
+    std::size_t releasedBytes = 0;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "entt.hpp"
+#include "JobSystem.hpp"
+#include "MappedScene.hpp"
+#include "NameTable.hpp"
+
+// Streams a .OmniScene into a registry without stalling the frame.
+// Workers copy fixed-size row ranges out of the mapping (taking the page
+// faults and disk reads); the main thread calls Pump() once per frame to
+// insert finished batches until its time budget is spent. Only live entities
+// are restored, with their saved identifiers.
+class SceneStreamer {
+public:
+    explicit SceneStreamer(JobSystem& jobs, std::size_t batchRows = 16384);
+    ~SceneStreamer();
+
+    SceneStreamer(const SceneStreamer&) = delete;
+    SceneStreamer& operator=(const SceneStreamer&) = delete;
+
+    // Clears the registry and names, then starts streaming the file into them
+    bool Begin(entt::registry& registry, NameTable* names, const std::string& path);
+
+    // Main thread, once per frame. Returns true while the scene is still streaming.
+    bool Pump(double budgetMs = 2.0);
+
+    // Stops decoding and drops batches that were not inserted yet
+    void Cancel();
+
+    bool Streaming() const { return registry != nullptr; }
+    // Fraction of rows inserted so far
+    float Progress() const;
+
+private:
+    enum class Kind { Entities, Components, Names };
+
+    using InsertFn = bool (*)(entt::registry&, const entt::entity*, const unsigned char*, std::size_t);
+
+    struct Batch {
+        Kind kind;
+        InsertFn insert = nullptr;
+        const SceneSnapshot::Section* section = nullptr;
+        std::size_t begin = 0;
+        std::size_t count = 0;
+        // Names only: where the batch's text starts in the section and its length
+        std::size_t textOffset = 0;
+        std::size_t textBytes = 0;
+        std::vector<unsigned char> data;   // entity ids, then the component or name bytes
+        std::atomic<bool> ready{false};
+    };
+
+    void AddBatches(Kind kind, InsertFn insert, const SceneSnapshot::Section& section, std::size_t first, std::size_t last);
+    void SubmitAhead();
+    void Decode(Batch& batch);
+    bool Insert(const Batch& batch);
+    void Finish();
+
+    JobSystem& jobs;
+    std::size_t batchRows;
+    JobSystem::Counter pending;
+    std::atomic<bool> cancelled{false};
+
+    entt::registry* registry = nullptr;
+    NameTable* names = nullptr;
+    std::string path;
+    MappedScene scene;
+    std::vector<std::unique_ptr<Batch>> batches;
+    std::size_t submitted = 0;
+    std::size_t inserted = 0;
+    std::size_t rowsInserted = 0;
+    std::size_t rowsTotal = 0;
+    int reportedTenths = 0;
+    std::chrono::steady_clock::time_point started;
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "entt.hpp"
+#include "CommandBuffer.hpp"
+#include "JobSystem.hpp"
+#include "SystemProfiler.hpp"
+
+// Component access declarations for Scheduler::AddSystem
+template<typename... Component>
+struct Reads {};
+
+template<typename... Component>
+struct Writes {};
+
+// Handed to each system while it runs
+class SystemContext {
+public:
+    SystemContext(entt::registry& registry, JobSystem& jobs, CommandQueue& commands, std::size_t systemIndex)
+        : registry(registry), jobs(jobs), commands(commands), systemIndex(systemIndex) {}
+
+    entt::registry& Registry() { return registry; }
+    JobSystem& Jobs() { return jobs; }
+
+    // Structural changes go through the calling thread's buffer and are
+    // played back once all systems have run
+    CommandBuffer& Commands() { return commands.Local(); }
+
+    // Entities the system visited, for the profiler. ParallelEach counts its
+    // own; systems that iterate by hand report theirs here (any thread).
+    void CountVisited(std::size_t count) { visited.fetch_add(count, std::memory_order_relaxed); }
+    std::uint64_t Visited() const { return visited.load(std::memory_order_relaxed); }
+
+    // Calls fn(entity, Component&...) for every entity in the view, with the
+    // leading storage split into chunks across the worker pool. fn must only
+    // touch the components the system declared.
+    template<typename... Component, typename Fn>
+    void ParallelEach(Fn&& fn, std::size_t grain = 1024) {
+        auto view = registry.view<Component...>();
+        const auto* leading = view.handle();
+        if (leading == nullptr) return;
+
+        jobs.ParallelFor(leading->size(), grain, [this, &view, &fn, leading](std::size_t begin, std::size_t end) {
+            // Key commands by chunk so playback order does not depend on which thread ran it
+            CommandBuffer& buffer = commands.Local();
+            const std::uint64_t previous = buffer.BeginBatch(BatchKey(begin + 1));
+
+            const entt::entity* entities = leading->data();
+            std::size_t count = 0;
+            for (std::size_t i = begin; i < end; i++) {
+                const entt::entity entity = entities[i];
+                if (view.contains(entity)) {
+                    fn(entity, view.template get<Component>(entity)...);
+                    count++;
+                }
+            }
+            CountVisited(count);
+            buffer.BeginBatch(previous);
+        });
+    }
+
+    // Commands recorded by the system body itself use chunk 0
+    std::uint64_t BatchKey(std::size_t chunk) const {
+        return (static_cast<std::uint64_t>(systemIndex) << 40) | chunk;
+    }
+
+private:
+    entt::registry& registry;
+    JobSystem& jobs;
+    CommandQueue& commands;
+    std::size_t systemIndex;
+    std::atomic<std::uint64_t> visited{0};
+};
+
+// Runs systems over a registry. Each system declares the components it reads
+// and writes; systems whose access sets do not conflict share a stage and run
+// concurrently, while conflicting systems keep their registration order.
+// Systems must not create or destroy entities or components directly; they
+// record into SystemContext::Commands(), which Run() plays back at the end.
+// Command buffers are per JobSystem worker and every thread outside the pool
+// counts as worker 0, so Schedulers that run at the same time on different
+// threads (one per world) each need their own JobSystem.
+class Scheduler {
+public:
+    using SystemFn = std::function<void(SystemContext&)>;
+
+    // With a profiler, every system run records its wall time, entities
+    // visited and worker thread there
+    Scheduler(entt::registry& registry, JobSystem& jobs, SystemProfiler* profiler = nullptr);
+
+    template<typename ReadList = Reads<>, typename WriteList = Writes<>>
+    void AddSystem(std::string name, SystemFn fn) {
+        System system;
+        system.name = std::move(name);
+        system.fn = std::move(fn);
+        Collect(ReadList{}, system.reads);
+        Collect(WriteList{}, system.writes);
+        AddSystem(std::move(system));
+    }
+
+    // Runs every system once, stage by stage, then plays back recorded commands
+    void Run();
+
+    std::size_t StageCount();
+
+private:
+    struct System {
+        std::string name;
+        std::vector<entt::id_type> reads;
+        std::vector<entt::id_type> writes;
+        SystemFn fn;
+        std::uint32_t profileId = 0;
+    };
+
+    // Creating storages up front keeps registry.view() read-only inside systems
+    template<template<typename...> class List, typename... Component>
+    void Collect(List<Component...>, std::vector<entt::id_type>& ids) {
+        (registry.storage<std::remove_const_t<Component>>(), ...);
+        (ids.push_back(entt::type_id<std::remove_const_t<Component>>().hash()), ...);
+    }
+
+    void AddSystem(System system);
+    void BuildStages();
+    void RunSystem(std::size_t index);
+    static bool Conflicts(const System& a, const System& b);
+
+    entt::registry& registry;
+    JobSystem& jobs;
+    SystemProfiler* profiler;
+    std::uint64_t frame = 0;
+    CommandQueue commands;
+    std::vector<System> systems;
+    std::vector<std::vector<std::size_t>> stages;
+    bool stagesDirty = false;
+};
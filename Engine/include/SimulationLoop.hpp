@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "entt.hpp"
+#include "ecs.hpp"
+#include "TransformSystem.hpp"
+#include "StateRing.hpp"
+
+// Transforms of every entity with Position, Rotation and Scale after one
+// simulation tick, in parallel arrays
+struct SimulationState {
+    std::uint64_t tick = 0;
+    std::int64_t dueNanoseconds = 0;   // steady_clock time the tick stands for
+    std::vector<entt::entity> entities;
+    std::vector<Position> positions;
+    std::vector<Rotation> rotations;
+    std::vector<Scale> scales;
+};
+
+// Runs the simulation at a fixed rate on its own thread, independent of the
+// display rate and vsync stalls.
+//
+// Each tick calls the step function with the registry locked, then captures
+// the transforms into a free slot of a StateRing and publishes it with one
+// atomic exchange; nothing else is copied. The render thread never touches
+// the registry or takes a lock for drawing: Interpolate() pins the two
+// newest states and blends them for the current time, drawn one tick
+// behind so there is always a state on either side. Rendering one frame
+// overlaps with simulating the next.
+//
+// Raw Position/Rotation/Scale are buffered rather than matrices, since
+// blending matrices would shear rotations.
+//
+// Anything else that touches the registry while the loop runs (editor,
+// scene streaming) must hold LockWorld().
+class SimulationLoop {
+public:
+    using StepFn = std::function<void(double stepSeconds)>;
+    using IdleFn = std::function<void(double budgetMs)>;
+
+    explicit SimulationLoop(entt::registry& registry, double ticksPerSecond = 60.0);
+    ~SimulationLoop();
+
+    SimulationLoop(const SimulationLoop&) = delete;
+    SimulationLoop& operator=(const SimulationLoop&) = delete;
+
+    // Set before Start()
+    void SetStep(StepFn fn) { step = std::move(fn); }
+    // Called with the world locked when a tick finishes early, with half of
+    // the time left before the next one (registry maintenance). Set before Start().
+    void SetIdle(IdleFn fn) { idle = std::move(fn); }
+
+    void Start();
+    void Stop();
+    bool Running() const { return thread.joinable(); }
+
+    // Blocks until the current tick (if any) has finished
+    std::unique_lock<std::mutex> LockWorld() { return std::unique_lock<std::mutex>(worldMutex); }
+
+    // Render thread: world matrices blended between the two latest states,
+    // in the order of the latest state's entities. False before the first tick.
+    bool Interpolate(std::vector<WorldMatrix>& out);
+
+    std::uint64_t Ticks() const { return ticks.load(std::memory_order_relaxed); }
+    double StepSeconds() const { return stepSeconds; }
+
+private:
+    // Ticks run late by more than this many steps are skipped, not replayed
+    static constexpr int maxCatchUpSteps = 8;
+
+    void Run();
+    void RunTick(std::int64_t dueNanoseconds);
+    void Capture(SimulationState& state);
+
+    entt::registry& registry;
+    double stepSeconds;
+    std::chrono::nanoseconds stepDuration;
+    StepFn step;
+    IdleFn idle;
+
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::atomic<std::uint64_t> ticks{0};
+    std::mutex worldMutex;
+
+    StateRing<SimulationState> states;
+
+    // Interpolate() scratch, render thread only
+    std::vector<Position> blendedPositions;
+    std::vector<Rotation> blendedRotations;
+    std::vector<Scale> blendedScales;
+    std::vector<std::uint32_t> previousIndex;
+};
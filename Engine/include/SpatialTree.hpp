@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "entt.hpp"
+#include "ChangeTracker.hpp"
+#include "Geometry.hpp"
+#include "JobSystem.hpp"
+
+// Dynamic AABB tree over every entity with Position and Scale (Rotation is
+// optional and tightens the bounds).
+//
+// Leaves hold bounds fattened by a margin, so an entity that moves a little
+// needs no tree update; one that leaves its fat box is removed and
+// reinserted. Reinsertions slowly degrade the tree, so when its surface-area
+// cost grows past a threshold a fresh tree is built on the JobSystem and
+// swapped in on a later Update().
+class SpatialTree {
+public:
+    explicit SpatialTree(entt::registry& registry, JobSystem* jobs = nullptr, float margin = 0.1f);
+    ~SpatialTree();
+
+    SpatialTree(const SpatialTree&) = delete;
+    SpatialTree& operator=(const SpatialTree&) = delete;
+
+    // Main thread, once per frame. Indexes new entities, refits those whose
+    // Position, Rotation or Scale changed after frame `since` (the tracker
+    // must Track<> all three) and manages the background rebuild.
+    void Update(const ChangeTracker& changes, std::uint64_t since);
+
+    // Builds the whole tree again from the registry, on the calling thread
+    void Rebuild();
+
+    // Queries test leaves against exact bounds, not the fattened ones
+    void QueryBox(const Aabb& box, std::vector<entt::entity>& out) const;
+    void QuerySphere(const float center[3], float radius, std::vector<entt::entity>& out) const;
+    void QueryFrustum(const Frustum& frustum, std::vector<entt::entity>& out) const;
+    // Closest entity whose bounds the ray enters within ray.maxDistance
+    bool Raycast(const Ray& ray, entt::entity& hit, float& distance) const;
+
+    std::size_t Size() const { return leafCount; }
+    int Height() const { return root == nullNode ? 0 : nodes[root].height; }
+
+    // Surface-area cost relative to the tree as last built (1 = as built)
+    float Quality() const;
+    // Quality above which a background rebuild starts
+    void SetRebuildThreshold(float ratio) { rebuildThreshold = ratio; }
+    bool Rebuilding() const { return pendingBuild != nullptr; }
+
+private:
+    static constexpr std::int32_t nullNode = -1;
+
+    struct Node {
+        Aabb box;               // fattened for leaves
+        std::int32_t parent;    // next free node while unused
+        std::int32_t left;      // nullNode for leaves
+        std::int32_t right;
+        std::int32_t height;    // 0 for leaves, -1 while unused
+        entt::entity entity;    // leaves only
+    };
+
+    // Per entity index: its leaf and exact bounds
+    struct Slot {
+        entt::entity entity = entt::null;
+        std::int32_t leaf = nullNode;
+        Aabb bounds;
+    };
+
+    struct BuildItem {
+        Aabb box;
+        entt::entity entity;
+    };
+
+    struct Build {
+        std::vector<BuildItem> items;
+        std::vector<Node> nodes;
+        std::int32_t root = nullNode;
+        JobSystem::Counter done;
+    };
+
+    void OnTouch(entt::registry&, entt::entity entity) { touched.push_back(entity); }
+    void OnRemove(entt::registry&, entt::entity entity) { Remove(entity); }
+
+    bool ComputeBounds(entt::entity entity, Aabb& bounds) const;
+    Aabb Fatten(const Aabb& bounds) const;
+    Slot& SlotOf(entt::entity entity);
+
+    void Refit(entt::entity entity);
+    void Remove(entt::entity entity);
+
+    std::int32_t AllocateNode();
+    void FreeNode(std::int32_t node);
+    void InsertLeaf(std::int32_t leaf);
+    void RemoveLeaf(std::int32_t leaf);
+    std::int32_t Balance(std::int32_t node);
+    void FixUpwards(std::int32_t node);
+
+    float Cost() const;
+    void StartBuild();
+    void AdoptBuild();
+    void CollectItems(std::vector<BuildItem>& items);
+    static std::int32_t BuildRange(std::vector<Node>& nodes, BuildItem* first, BuildItem* last, std::int32_t parent);
+    void Install(std::vector<Node>&& built, std::int32_t builtRoot);
+
+    entt::registry& registry;
+    JobSystem* jobs;
+    float margin;
+    float rebuildThreshold = 1.5f;
+
+    std::vector<Node> nodes;
+    std::int32_t root = nullNode;
+    std::int32_t freeList = nullNode;
+    std::size_t leafCount = 0;
+    std::vector<Slot> slots;
+
+    float builtCost = 0.0f;
+    std::size_t reinsertsSinceCheck = 0;
+    std::unique_ptr<Build> pendingBuild;
+    std::vector<entt::entity> addedDuringBuild;
+
+    std::vector<entt::entity> touched;
+    std::vector<entt::entity> changed;
+    std::vector<entt::scoped_connection> connections;
+};
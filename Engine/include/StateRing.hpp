@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer handoff of the two newest values.
+//
+// Four slots, each holding one value. The writer fills a slot the reader
+// cannot see and publishes it as the latest; the value published before it
+// becomes the previous. Acquire() pins the published pair for the reader
+// until its next call, so neither side copies a value or waits on the other.
+// The writer only fills slots that are neither published nor pinned. When
+// the reader still pins an older pair, that leaves nothing free, so the
+// writer withdraws the published previous first and the reader gets the
+// latest alone until the next publish. Slot contents are reused, so
+// containers in T keep their capacity from value to value.
+template<typename T>
+class StateRing {
+public:
+    StateRing() = default;
+    StateRing(const StateRing&) = delete;
+    StateRing& operator=(const StateRing&) = delete;
+
+    // Writer thread: the slot to fill next; holds whatever value was there before
+    T& Back() { return slots[back]; }
+
+    // Writer thread: publishes the back slot as the latest and takes a free one
+    void Publish() {
+        std::uint32_t word = published.load(std::memory_order_relaxed);
+        while (!published.compare_exchange_weak(word, With(With(word, latestShift, back), previousShift, Field(word, latestShift)),
+                                                std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        }
+        back = TakeFree();
+    }
+
+    // Reader thread: pins the newest published pair; Latest() and Previous()
+    // stay the same until the next call
+    void Acquire() {
+        std::uint32_t word = published.load(std::memory_order_acquire);
+        std::uint32_t pinned;
+        do {
+            pinned = With(With(word, pinnedLatestShift, Field(word, latestShift)), pinnedPreviousShift, Field(word, previousShift));
+        } while (pinned != word && !published.compare_exchange_weak(word, pinned, std::memory_order_acq_rel, std::memory_order_acquire));
+        latest = Field(pinned, latestShift);
+        previous = Field(pinned, previousShift);
+    }
+
+    // Reader thread: nullptr before the first publish
+    const T* Latest() const { return latest == none ? nullptr : &slots[latest]; }
+    // Reader thread: the value published just before Latest(), or nullptr
+    const T* Previous() const { return previous == none ? nullptr : &slots[previous]; }
+
+private:
+    static constexpr std::uint32_t none = 0xFF;
+    // One byte per slot index in the shared word
+    static constexpr int latestShift = 0;
+    static constexpr int previousShift = 8;
+    static constexpr int pinnedLatestShift = 16;
+    static constexpr int pinnedPreviousShift = 24;
+
+    static std::uint32_t Field(std::uint32_t word, int shift) { return (word >> shift) & 0xFF; }
+    static std::uint32_t With(std::uint32_t word, int shift, std::uint32_t value) {
+        return (word & ~(0xFFu << shift)) | (value << shift);
+    }
+
+    // A slot nobody can read, withdrawing the published previous if all four are in use
+    std::uint32_t TakeFree() {
+        std::uint32_t word = published.load(std::memory_order_acquire);
+        for (;;) {
+            for (std::uint32_t slot = 0; slot < 4; slot++) {
+                if (slot != Field(word, latestShift) && slot != Field(word, previousShift) &&
+                    slot != Field(word, pinnedLatestShift) && slot != Field(word, pinnedPreviousShift)) return slot;
+            }
+            const std::uint32_t withdrawn = Field(word, previousShift);
+            if (published.compare_exchange_weak(word, With(word, previousShift, none), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return withdrawn;
+            }
+        }
+    }
+
+    T slots[4];
+    alignas(64) std::uint32_t back = 0;
+    alignas(64) std::atomic<std::uint32_t> published{0xFFFFFFFFu};
+    alignas(64) std::uint32_t latest = none;
+    std::uint32_t previous = none;
+};
@@ -1,5 +1,11 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace Status {
@@ -21,27 +27,211 @@ namespace Status {
         Cancelled     // darkish red
     };
 
+    constexpr std::size_t logTypeCount = static_cast<std::size_t>(LogType::Cancelled) + 1;
+
+    // A message points into the history's byte ring; valid until the next
+    // call that drains or clears it. Entries logged through Log() keep their
+    // format and encoded arguments instead of text, see Text().
     struct LogEntry {
         LogType type;
-        std::string message;
+        std::string_view message;
+        const char* format = nullptr;
+
+        // The text; formatted into scratch for Log() entries, else the message itself
+        std::string_view Text(std::string& scratch) const;
+        void AppendText(std::string& out) const;
     };
 
-    // Setters - Called by library modules to update the engine status
-    void SetLoadingStatus(const std::string& s);
-    void SetRuntimeStatus(const std::string& s);
-    void SetError(const std::string& s);
-    void SetWarning(const std::string& s);
-    void SetInfo(const std::string& s);
-    void SetDebug(const std::string& s);
-    void SetTrace(const std::string& s);
-    void SetFatal(const std::string& s);
-    void SetUnknown(const std::string& s);
-    void SetSuccess(const std::string& s);
-    void SetFailure(const std::string& s);
-    void SetPending(const std::string& s);
-    void SetCancelled(const std::string& s);
-
-    // Getters - Called by the main program to read the status
+    // Fixed-capacity log history. Message bytes are packed back to back into
+    // one ring and indexed by a ring of small records, so appending never
+    // allocates once both rings exist and iterating walks two contiguous
+    // arrays. When either ring is full the oldest entries are evicted and
+    // counted in Dropped(). Every entry also gets a sequence number, never
+    // reused (not even after Clear()), and a per-type index of them, so a
+    // view of one type finds its entries without scanning the others.
+    class LogHistory {
+    public:
+        // Defaults hold 1 MiB of text in at most 16384 entries
+        explicit LogHistory(std::size_t byteCapacity = std::size_t{1} << 20,
+                            std::size_t entryCapacity = std::size_t{1} << 14);
+
+        // Messages longer than the byte ring are truncated to fit
+        void Push(LogType type, std::string_view message, const char* format = nullptr);
+        // Pushes every entry of other, oldest first, and adds its drop count
+        void Append(const LogHistory& other);
+        void Clear();
+
+        std::size_t Size() const { return count; }
+        bool Empty() const { return count == 0; }
+        // Entries evicted to make room since the last Clear()
+        std::uint64_t Dropped() const { return dropped; }
+        // Both rings; fixed once the first entry is in
+        std::size_t MemoryBytes() const { return bytes.capacity() + records.capacity() * sizeof(Record); }
+        // 0 is the oldest entry still held
+        LogEntry operator[](std::size_t i) const {
+            const Record& record = records[(first + i) & recordMask];
+            return {record.type, std::string_view(bytes.data() + record.offset, record.length), record.format};
+        }
+
+        // Sequence numbers of the oldest entry held and of the next one pushed
+        std::uint64_t FirstSequence() const { return head; }
+        std::uint64_t EndSequence() const { return head + count; }
+        LogEntry At(std::uint64_t sequence) const { return (*this)[static_cast<std::size_t>(sequence - head)]; }
+
+        // Entries of one type, oldest first: how many are held, the sequence of
+        // the i-th, and the index of the first at or after a sequence
+        std::size_t CountOf(LogType type) const {
+            const std::size_t t = static_cast<std::size_t>(type);
+            return typeSequences[t].size() - typeFirst[t];
+        }
+        std::uint64_t SequenceOf(LogType type, std::size_t i) const {
+            const std::size_t t = static_cast<std::size_t>(type);
+            return typeSequences[t][typeFirst[t] + i];
+        }
+        std::size_t FindOf(LogType type, std::uint64_t sequence) const;
+
+        class Iterator {
+        public:
+            Iterator(const LogHistory* history, std::size_t index) : history(history), index(index) {}
+            LogEntry operator*() const { return (*history)[index]; }
+            Iterator& operator++() { index++; return *this; }
+            bool operator!=(const Iterator& other) const { return index != other.index; }
+
+        private:
+            const LogHistory* history;
+            std::size_t index;
+        };
+        Iterator begin() const { return Iterator(this, 0); }
+        Iterator end() const { return Iterator(this, count); }
+
+    private:
+        struct Record {
+            const char* format;
+            std::uint32_t offset;
+            std::uint32_t length;
+            LogType type;
+        };
+
+        void EvictOldest();
+
+        std::size_t byteCapacity;
+        std::size_t recordMask;
+        // Both rings are allocated on the first Push()
+        std::vector<char> bytes;
+        std::vector<Record> records;
+        std::size_t first = 0;       // record index of the oldest entry
+        std::size_t count = 0;
+        std::size_t writeOffset = 0; // where the next message's bytes go
+        std::uint64_t head = 0;      // sequence of the oldest entry
+        std::uint64_t dropped = 0;
+        // Sequences per type; evicted ones are skipped by typeFirst and
+        // erased once they make up half the vector
+        std::vector<std::uint64_t> typeSequences[logTypeCount];
+        std::size_t typeFirst[logTypeCount] = {};
+    };
+
+    // Setters - Called by library modules to update the engine status, from
+    // any thread. Entries go into a lock-free queue (a copy of the text, no
+    // lock, no allocation once warm) and reach the history when it is drained.
+    void SetLoadingStatus(std::string_view s);
+    void SetRuntimeStatus(std::string_view s);
+    void SetError(std::string_view s);
+    void SetWarning(std::string_view s);
+    void SetInfo(std::string_view s);
+    void SetDebug(std::string_view s);
+    void SetTrace(std::string_view s);
+    void SetFatal(std::string_view s);
+    void SetUnknown(std::string_view s);
+    void SetSuccess(std::string_view s);
+    void SetFailure(std::string_view s);
+    void SetPending(std::string_view s);
+    void SetCancelled(std::string_view s);
+
+    // Deferred formatting: Log() queues the format's address and the raw
+    // arguments as a binary record, and the text is only built when
+    // something reads it (the Output panel, once the line scrolls into view;
+    // a getter; LogEntry::Text()).
+    // Each "{}" in the format takes the next argument; formats must be string
+    // literals, since only their address is kept. Arguments may be integers,
+    // enums, floating point, bools, chars and anything that converts to
+    // std::string_view (copied into the record).
+    //
+    //   Status::Log(Status::LogType::Runtime, "Entity {} created", entityName);
+    struct LogFormat {
+        template<std::size_t N>
+        constexpr LogFormat(const char (&literal)[N]) : text(literal) {}
+        const char* text;
+    };
+
+    // Argument encoding: a tag, then 8 bytes for numbers, 1 for bools, or a
+    // 4-byte length and the bytes for text
+    namespace LogArgs {
+        enum Tag : char { Signed = 'i', Unsigned = 'u', Floating = 'f', Boolean = 'b', Text = 's' };
+
+        template<typename T>
+        constexpr bool isText = std::is_convertible_v<const T&, std::string_view>;
+
+        template<typename T>
+        std::size_t Size(const T& value) {
+            if constexpr (isText<T>) {
+                return 1 + sizeof(std::uint32_t) + std::string_view(value).size();
+            } else if constexpr (std::is_same_v<T, char>) {
+                return 1 + sizeof(std::uint32_t) + 1;
+            } else if constexpr (std::is_same_v<T, bool>) {
+                return 2;
+            } else {
+                static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Status::Log argument type");
+                return 1 + 8;
+            }
+        }
+
+        inline char* WriteText(char* out, std::string_view text) {
+            const auto length = static_cast<std::uint32_t>(text.size());
+            *out++ = Tag::Text;
+            std::memcpy(out, &length, sizeof(length));
+            std::memcpy(out + sizeof(length), text.data(), length);
+            return out + sizeof(length) + length;
+        }
+
+        template<typename T>
+        char* Write(char* out, const T& value) {
+            if constexpr (isText<T>) {
+                return WriteText(out, std::string_view(value));
+            } else if constexpr (std::is_same_v<T, char>) {
+                return WriteText(out, std::string_view(&value, 1));
+            } else if constexpr (std::is_same_v<T, bool>) {
+                out[0] = Tag::Boolean;
+                out[1] = value ? 1 : 0;
+                return out + 2;
+            } else if constexpr (std::is_enum_v<T>) {
+                return Write(out, static_cast<std::underlying_type_t<T>>(value));
+            } else {
+                using Stored = std::conditional_t<std::is_floating_point_v<T>, double,
+                                                  std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+                const Stored stored = static_cast<Stored>(value);
+                *out++ = std::is_floating_point_v<T> ? Tag::Floating : std::is_signed_v<T> ? Tag::Signed : Tag::Unsigned;
+                std::memcpy(out, &stored, 8);
+                return out + 8;
+            }
+        }
+    }
+
+    // Claims a queue slot and has write fill its size bytes with the record
+    using RecordWriter = void (*)(char* out, const void* arguments);
+    void PublishRecord(LogType type, const char* format, std::size_t size, RecordWriter write, const void* arguments);
+
+    template<typename... Args>
+    void Log(LogType type, LogFormat format, const Args&... args) {
+        const std::tuple<const Args&...> arguments(args...);
+        const std::size_t size = (std::size_t{0} + ... + LogArgs::Size(args));
+        PublishRecord(type, format.text, size, [](char* out, const void* packed) {
+            std::apply([&](const auto&... value) { ((out = LogArgs::Write(out, value)), ...); },
+                       *static_cast<const std::tuple<const Args&...>*>(packed));
+        }, &arguments);
+    }
+
+    // Getters - Called by the main program to read (and reset) the latest
+    // status of each type; they drain pending entries first
     std::string GetLoadingStatus();
     std::string GetRuntimeStatus();
     std::string GetError();
@@ -56,7 +246,11 @@ namespace Status {
     std::string GetPending();
     std::string GetCancelled();
 
-    // Get all log entries for display
-    const std::vector<LogEntry>& GetAllLogs();
+    // History functions belong to the thread that displays the logs (the UI),
+    // which drains the queue once per frame through GetAllLogs(). The
+    // returned history only changes on that thread's own Status calls; it
+    // keeps the newest entries that fit and counts the rest as dropped.
+    void Drain();
+    const LogHistory& GetAllLogs();
     void ClearAllLogs();
 }
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Per-system timings from the Scheduler.
+//
+// Systems record one Sample per run from whichever thread ran them into a
+// bounded lock-free ring; nothing blocks, and a full ring drops the sample
+// and counts it. The editor drains the ring once per frame on the main
+// thread and folds the samples into per-system aggregates.
+class SystemProfiler {
+public:
+    struct Sample {
+        std::uint32_t system;        // id from Register()
+        std::uint32_t worker;        // JobSystem::CurrentWorker(), 0 = calling thread
+        std::uint64_t frame;
+        std::uint64_t nanoseconds;   // wall time of the system body
+        std::uint64_t entities;      // entities visited, see SystemContext::CountVisited
+    };
+
+    struct Stats {
+        std::string name;
+        std::uint64_t runs = 0;
+        std::uint64_t totalNanoseconds = 0;
+        std::uint64_t minNanoseconds = 0;
+        std::uint64_t maxNanoseconds = 0;
+        std::uint64_t lastNanoseconds = 0;
+        std::uint64_t totalEntities = 0;
+        std::uint64_t lastEntities = 0;
+        std::uint32_t lastWorker = 0;
+        std::uint64_t lastFrame = 0;
+
+        double MeanMilliseconds() const { return runs == 0 ? 0.0 : totalNanoseconds / 1e6 / runs; }
+    };
+
+    // Capacity is rounded up to a power of two
+    explicit SystemProfiler(std::size_t capacity = 4096);
+
+    SystemProfiler(const SystemProfiler&) = delete;
+    SystemProfiler& operator=(const SystemProfiler&) = delete;
+
+    // Main thread, before the system first runs; returns its id
+    std::uint32_t Register(const std::string& name);
+
+    // Any thread. False when the ring is full and the sample was dropped.
+    bool Record(const Sample& sample);
+
+    // Consumer side, one thread at a time (the editor's main thread)
+    void Drain();
+    const std::vector<Stats>& Systems() const { return systems; }
+    std::uint64_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+    // Clears the aggregates; registered systems keep their ids
+    void Reset();
+
+    // Aggregates as JSON, for comparing runs offline
+    bool ExportJson(const std::string& path) const;
+
+private:
+    // Bounded multi-producer queue: a slot is free for position p while its
+    // sequence equals p and holds a sample once it reads p + 1
+    struct Slot {
+        std::atomic<std::uint64_t> sequence;
+        Sample sample;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::uint64_t mask;
+    alignas(64) std::atomic<std::uint64_t> head{0};
+    alignas(64) std::uint64_t tail = 0;
+    std::atomic<std::uint64_t> dropped{0};
+
+    std::vector<Stats> systems;
+};
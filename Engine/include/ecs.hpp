@@ -1,6 +1,19 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
+#include "entt.hpp"
+#include "NameTable.hpp"
+
+class Prefab;
+class SceneStreamer;
+class SpatialGrid;
+class SystemProfiler;
+struct Float3Text;
 
 // Component structures for ECS
 struct Position {
@@ -23,18 +36,113 @@ struct Scale {
     Scale(float x = 1, float y = 1, float z = 1) : x(x), y(y), z(z) {}
 };
 
+// Component types stored in scenes, with the stable names used on disk and by the editor
+using SceneComponents = entt::type_list<Position, Transform, Rotation, Scale>;
+
+template<typename Component>
+inline constexpr const char* componentName = nullptr;
+template<> inline constexpr const char* componentName<Position> = "Position";
+template<> inline constexpr const char* componentName<Transform> = "Transform";
+template<> inline constexpr const char* componentName<Rotation> = "Rotation";
+template<> inline constexpr const char* componentName<Scale> = "Scale";
+
+// Index of a SceneComponents type in the ComponentRegistry table
+using ComponentId = std::uint32_t;
+inline constexpr ComponentId invalidComponent = ~ComponentId{0};
+
+// One world: an ECS owns its registry, entity names, spatial grid and
+// system profiler, and shares no mutable state with other instances, so
+// independent worlds (an editor scene and its play-mode copy, server
+// instances) can be simulated on different threads at the same time. A
+// single ECS is not thread-safe; see Scheduler and SimulationLoop.
+//
+// Entities are addressed by entt::entity handles. Names are optional and
+// interned once at creation; resolve a name with FindEntity() outside of hot
+// loops and keep the handle. A name is released whenever its entity is
+// destroyed, whether through DeleteEntity() or the registry directly.
 class ECS {
 public:
-    void CreateEntity(std::string entityID);
-    void DeleteEntity(std::string entityID);
-    void AddComponent(std::string entityID, std::string componentName);
-    void RemoveComponent(std::string entityID, std::string componentName);
-    void GetComponent(std::string entityID, std::string componentName);
-    void SetComponent(std::string entityID, std::string componentName, std::string componentValue);
-    void GetComponentValue(std::string entityID, std::string componentName);
-    void SetComponentValue(std::string entityID, std::string componentName, std::string componentValue);
-    void GetEntity(std::string entityID);
-    void SetEntity(std::string entityID, std::string entityName);
-    void GetEntityValue(std::string entityID, std::string entityName);
-    void SetEntityValue(std::string entityID, std::string entityName, std::string entityValue);
-};
\ No newline at end of file
+    ECS();
+    ~ECS();
+
+    // The grid and any systems hold on to Registry(), so worlds stay put
+    ECS(const ECS&) = delete;
+    ECS& operator=(const ECS&) = delete;
+
+    entt::entity CreateEntity(std::string_view entityName = {});
+    void DeleteEntity(entt::entity entity);
+
+    // Bulk creation: one range create plus one insert per storage, all
+    // reserved up front. Entities are unnamed and share the given values.
+    void CreateEntities(entt::entity* first, entt::entity* last, const Position& position = {},
+                        const Rotation& rotation = {}, const Scale& scale = {});
+    std::vector<entt::entity> CreateEntities(std::size_t count, const Position& position = {},
+                                             const Rotation& rotation = {}, const Scale& scale = {});
+    // Unnamed copies of a prefab, see Prefab.hpp
+    std::vector<entt::entity> Instantiate(const Prefab& prefab, std::size_t count);
+    bool IsValid(entt::entity entity);
+
+    // Returns entt::null if no entity has this name
+    entt::entity FindEntity(std::string_view entityName) const;
+    std::string_view GetEntityName(entt::entity entity) const;
+    bool SetEntityName(entt::entity entity, std::string_view entityName);
+
+    // Typed component access
+    template<typename Component, typename... Args>
+    Component& AddComponent(entt::entity entity, Args&&... args) {
+        return Registry().emplace_or_replace<Component>(entity, std::forward<Args>(args)...);
+    }
+
+    template<typename Component>
+    void RemoveComponent(entt::entity entity) { Registry().remove<Component>(entity); }
+
+    template<typename Component>
+    bool HasComponent(entt::entity entity) { return Registry().all_of<Component>(entity); }
+
+    template<typename Component>
+    Component& GetComponent(entt::entity entity) { return Registry().get<Component>(entity); }
+
+    template<typename Component>
+    Component* TryGetComponent(entt::entity entity) { return Registry().try_get<Component>(entity); }
+
+    template<typename Component>
+    void SetComponentValue(entt::entity entity, const Component& value) { Registry().replace<Component>(entity, value); }
+
+    // Name-addressed component access for the editor and scripts. Names are
+    // looked up in the ComponentRegistry on every call; resolve them once with
+    // FindComponent() and use the ComponentId overloads where it matters.
+    ComponentId FindComponent(std::string_view componentName) const;
+    bool AddComponent(entt::entity entity, ComponentId component);
+    bool RemoveComponent(entt::entity entity, ComponentId component);
+    bool HasComponent(entt::entity entity, ComponentId component);
+    bool GetComponentValue(entt::entity entity, ComponentId component, float out[3]);
+    bool SetComponentValue(entt::entity entity, ComponentId component, const float value[3]);
+
+    bool AddComponent(entt::entity entity, std::string_view componentName);
+    bool RemoveComponent(entt::entity entity, std::string_view componentName);
+    bool HasComponent(entt::entity entity, std::string_view componentName);
+    std::string GetComponentValue(entt::entity entity, std::string_view componentName);
+    // Same text without allocating, see Float3Text.hpp
+    bool GetComponentValue(entt::entity entity, std::string_view componentName, Float3Text& out);
+    bool SetComponentValue(entt::entity entity, std::string_view componentName, std::string_view componentValue);
+
+    // Binary .OmniScene files (see SceneSnapshot.hpp); loading replaces the current scene
+    bool SaveScene(const std::string& path);
+    bool LoadScene(const std::string& path);
+    // Starts streaming a scene in through streamer; call streamer.Pump() every frame
+    bool StreamScene(SceneStreamer& streamer, const std::string& path);
+
+    entt::registry& Registry();
+    // Spatial hash over the registry's Positions; Rebuild() it once per frame
+    SpatialGrid& Grid();
+    // Shared by the Schedulers that run over Registry(); shown in the editor's Output panel
+    SystemProfiler& Profiler();
+
+private:
+    void OnDestroy(entt::registry&, entt::entity entity);
+
+    entt::registry registry;
+    NameTable entityNames;
+    std::unique_ptr<SpatialGrid> spatialGrid;
+    std::unique_ptr<SystemProfiler> systemProfiler;
+};
@@ -0,0 +1,54 @@
+#include "ChangeTracker.hpp"
+#include <algorithm>
+
+static std::size_t EntityIndex(entt::entity entity) {
+    return static_cast<std::size_t>(entt::to_entity(entity));
+}
+
+ChangeTracker::ChangeTracker(entt::registry& registry) : registry(registry) {}
+
+ChangeTracker::ComponentLog* ChangeTracker::FindLog(entt::id_type type) const {
+    for (const auto& [id, log] : logs) {
+        if (id == type) return log.get();
+    }
+    return nullptr;
+}
+
+void ChangeTracker::Stamp(ComponentLog& log, entt::entity entity) {
+    const std::size_t index = EntityIndex(entity);
+    if (index >= log.lastFrame.size()) {
+        log.lastFrame.resize(index + 1, 0);
+        log.lastEntity.resize(index + 1, entt::null);
+    }
+
+    // One entry per entity per frame
+    if (log.lastFrame[index] == frame && log.lastEntity[index] == entity) return;
+
+    log.lastFrame[index] = frame;
+    log.lastEntity[index] = entity;
+    log.entries.push_back({frame, entity});
+}
+
+void ChangeTracker::Forget(ComponentLog& log, entt::entity entity) {
+    const std::size_t index = EntityIndex(entity);
+    if (index < log.lastFrame.size() && log.lastEntity[index] == entity) log.lastFrame[index] = 0;
+}
+
+void ChangeTracker::Collect(const ComponentLog& log, std::uint64_t since, std::vector<entt::entity>& out) const {
+    auto first = std::upper_bound(log.entries.begin(), log.entries.end(), since,
+                                  [](std::uint64_t value, const Entry& entry) { return value < entry.frame; });
+
+    // Only the newest entry of an entity is still "live", which also drops removed components
+    for (; first != log.entries.end(); ++first) {
+        const std::size_t index = EntityIndex(first->entity);
+        if (log.lastFrame[index] == first->frame && log.lastEntity[index] == first->entity) out.push_back(first->entity);
+    }
+}
+
+void ChangeTracker::Trim(std::uint64_t upTo) {
+    for (auto& [id, log] : logs) {
+        auto last = std::upper_bound(log->entries.begin(), log->entries.end(), upTo,
+                                     [](std::uint64_t value, const Entry& entry) { return value < entry.frame; });
+        log->entries.erase(log->entries.begin(), last);
+    }
+}
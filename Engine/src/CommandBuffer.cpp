@@ -0,0 +1,159 @@
+#include "CommandBuffer.hpp"
+#include <algorithm>
+#include "JobSystem.hpp"
+
+CommandBuffer::~CommandBuffer() {
+    Clear();
+}
+
+std::uint64_t CommandBuffer::BeginBatch(std::uint64_t key) {
+    const std::uint64_t previous = currentKey;
+    currentKey = key;
+    return previous;
+}
+
+DeferredEntity CommandBuffer::Create() {
+    Record({Op::Create, createCount, entt::null, nullptr, nullptr, nullptr});
+    return DeferredEntity{createCount++};
+}
+
+void CommandBuffer::Destroy(entt::entity entity) {
+    Record({Op::Destroy, noDeferred, entity, nullptr, nullptr, nullptr});
+}
+
+void CommandBuffer::Destroy(DeferredEntity entity) {
+    Record({Op::Destroy, entity.index, entt::null, nullptr, nullptr, nullptr});
+}
+
+void CommandBuffer::Record(const Command& command) {
+    if (batches.empty() || batches.back().key != currentKey) {
+        batches.push_back({currentKey, commands.size()});
+    }
+    commands.push_back(command);
+}
+
+void* CommandBuffer::Allocate(std::size_t size, std::size_t align) {
+    for (;;) {
+        if (blockIndex < blocks.size()) {
+            const auto base = reinterpret_cast<std::uintptr_t>(blocks[blockIndex].get());
+            const std::uintptr_t at = (base + blockUsed + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+            if (at + size <= base + blockSizes[blockIndex]) {
+                blockUsed = at + size - base;
+                return reinterpret_cast<void*>(at);
+            }
+            if (blockUsed != 0) {
+                blockIndex++;
+                blockUsed = 0;
+                continue;
+            }
+        }
+
+        // Out of blocks, or the next one is too small for this payload
+        const std::size_t bytes = std::max(blockSize, size + align);
+        blocks.insert(blocks.begin() + static_cast<std::ptrdiff_t>(blockIndex), std::unique_ptr<unsigned char[]>(new unsigned char[bytes]));
+        blockSizes.insert(blockSizes.begin() + static_cast<std::ptrdiff_t>(blockIndex), bytes);
+        blockUsed = 0;
+    }
+}
+
+std::size_t CommandBuffer::BatchEnd(std::size_t batch) const {
+    return batch + 1 < batches.size() ? batches[batch + 1].first : commands.size();
+}
+
+entt::entity CommandBuffer::Resolve(const Command& command) const {
+    return command.deferred != noDeferred ? resolved[command.deferred] : command.entity;
+}
+
+void CommandBuffer::Apply(entt::registry& registry, const Command& command, entt::entity target) {
+    if (command.op == Op::Create || !registry.valid(target)) return;
+
+    if (command.op == Op::Destroy) {
+        registry.destroy(target);
+    } else {
+        command.apply(registry, target, command.payload);
+    }
+}
+
+void CommandBuffer::Playback(entt::registry& registry) {
+    resolved.resize(createCount);
+    registry.create(resolved.begin(), resolved.end());
+
+    for (const Command& command : commands) {
+        Apply(registry, command, Resolve(command));
+    }
+    Clear();
+}
+
+void CommandBuffer::Clear() {
+    for (const Command& command : commands) {
+        if (command.destroy != nullptr) command.destroy(command.payload);
+    }
+    commands.clear();
+    batches.clear();
+    resolved.clear();
+    currentKey = 0;
+    createCount = 0;
+    blockIndex = 0;
+    blockUsed = 0;
+}
+
+CommandQueue::CommandQueue(std::size_t threadCount) {
+    buffers.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; i++) {
+        buffers.push_back(std::make_unique<CommandBuffer>());
+    }
+}
+
+CommandBuffer& CommandQueue::Local() {
+    return *buffers[JobSystem::CurrentWorker()];
+}
+
+bool CommandQueue::Empty() const {
+    for (const auto& buffer : buffers) {
+        if (!buffer->Empty()) return false;
+    }
+    return true;
+}
+
+void CommandQueue::Playback(entt::registry& registry) {
+    struct Span {
+        std::uint64_t key;
+        CommandBuffer* buffer;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    std::vector<Span> spans;
+    std::size_t createTotal = 0;
+    for (const auto& buffer : buffers) {
+        for (std::size_t b = 0; b < buffer->batches.size(); b++) {
+            spans.push_back({buffer->batches[b].key, buffer.get(), buffer->batches[b].first, buffer->BatchEnd(b)});
+        }
+        createTotal += buffer->createCount;
+        buffer->resolved.resize(buffer->createCount);
+    }
+    if (spans.empty()) return;
+
+    // Stable: equal keys keep thread order, then record order
+    std::stable_sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) { return a.key < b.key; });
+
+    // Allocate every new entity in one range, handed out in merged order
+    std::vector<entt::entity> created(createTotal);
+    registry.create(created.begin(), created.end());
+    std::size_t next = 0;
+    for (const Span& span : spans) {
+        for (std::size_t i = span.first; i < span.last; i++) {
+            const CommandBuffer::Command& command = span.buffer->commands[i];
+            if (command.op == CommandBuffer::Op::Create) span.buffer->resolved[command.deferred] = created[next++];
+        }
+    }
+
+    for (const Span& span : spans) {
+        for (std::size_t i = span.first; i < span.last; i++) {
+            const CommandBuffer::Command& command = span.buffer->commands[i];
+            CommandBuffer::Apply(registry, command, span.buffer->Resolve(command));
+        }
+    }
+
+    for (const auto& buffer : buffers) buffer->Clear();
+}
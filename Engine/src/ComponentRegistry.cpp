@@ -0,0 +1,42 @@
+#include "ComponentRegistry.hpp"
+#include <algorithm>
+
+namespace {
+
+    struct NameIndex {
+        entt::id_type hash;
+        ComponentId id;
+    };
+
+    // Table ids ordered by name hash, for a binary search at lookup
+    constexpr std::array<NameIndex, ComponentRegistry::Count()> BuildIndex() {
+        std::array<NameIndex, ComponentRegistry::Count()> index{};
+        for (std::size_t i = 0; i < index.size(); i++) {
+            NameIndex entry{ComponentRegistry::table[i].nameHash, static_cast<ComponentId>(i)};
+            std::size_t j = i;
+            for (; j > 0 && index[j - 1].hash > entry.hash; j--) index[j] = index[j - 1];
+            index[j] = entry;
+        }
+        return index;
+    }
+
+    constexpr auto byHash = BuildIndex();
+
+    constexpr bool HashesUnique() {
+        for (std::size_t i = 1; i < byHash.size(); i++) {
+            if (byHash[i - 1].hash == byHash[i].hash) return false;
+        }
+        return true;
+    }
+
+    static_assert(HashesUnique(), "Two component names hash to the same value");
+}
+
+ComponentId ComponentRegistry::Find(std::string_view name) {
+    const entt::id_type hash = entt::hashed_string::value(name.data(), name.size());
+    const auto it = std::lower_bound(byHash.begin(), byHash.end(), hash,
+                                     [](const NameIndex& entry, entt::id_type value) { return entry.hash < value; });
+    // The hash only narrows it down; the one candidate is confirmed by name
+    if (it == byHash.end() || it->hash != hash || table[it->id].name != name) return invalidComponent;
+    return it->id;
+}
@@ -3,16 +3,28 @@
 #include "entt.hpp"
 #include <filesystem>
 #include "Status.hpp"
+#ifdef __APPLE__
 #include <CoreFoundation/CoreFoundation.h>
+#endif
 
 
 namespace fs = std::filesystem;
 
-std::string home = getenv("HOME"); // already includes /Users/USERNAME
+static std::string HomeDirectory() {
+    const char* home = getenv("HOME");
+    return home != nullptr ? home : ".";
+}
+
+std::string home = HomeDirectory(); // already includes /Users/USERNAME
+#ifdef __APPLE__
 std::string omnix_projects = home + "/Library/Application Support/Omnix/Omnix Projects";
+#else
+std::string omnix_projects = home + "/.local/share/Omnix/Omnix Projects";
+#endif
 
 
 
+#ifdef __APPLE__
 std::string GetResourcePath(const std::string& filename) {
     CFBundleRef mainBundle = CFBundleGetMainBundle();
     CFStringRef cfName = CFStringCreateWithCString(NULL, filename.c_str(), kCFStringEncodingUTF8);
@@ -27,6 +39,12 @@ std::string GetResourcePath(const std::string& filename) {
     CFRelease(resourceURL);
     return std::string(path);
 }
+#else
+// No app bundle: resources sit next to the working directory
+std::string GetResourcePath(const std::string& filename) {
+    return fs::exists(filename) ? fs::absolute(filename).string() : "";
+}
+#endif
 
 
 
@@ -61,4 +79,6 @@ void EngineInit::Init(int StartEngineMode, std::string ProjectName, bool NewProj
     Status::SetLoadingStatus("Engine initialized in mode " + std::to_string(StartEngineMode) + " in project " + ProjectName);
 }
 
-
+std::string EngineInit::ProjectPath(const std::string& ProjectName) const {
+    return omnix_projects + "/" + ProjectName;
+}
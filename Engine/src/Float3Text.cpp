@@ -0,0 +1,89 @@
+#include "Float3Text.hpp"
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Floating-point from_chars/to_chars arrived late in some standard libraries
+// (libc++ among them); the fallback keeps to stack buffers as well
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define OMNIX_FLOAT_CHARCONV 1
+#else
+#define OMNIX_FLOAT_CHARCONV 0
+#endif
+
+namespace {
+
+    bool IsSeparator(char c) {
+        return c == ' ' || c == '\t' || c == ',';
+    }
+
+    bool IsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    // Parses one number at [first, last); returns where it stopped, or nullptr
+    const char* ParseFloat(const char* first, const char* last, float& out) {
+        // from_chars does not take a leading '+'
+        if (first != last && *first == '+') first++;
+#if OMNIX_FLOAT_CHARCONV
+        const auto [end, error] = std::from_chars(first, last, out);
+        return error == std::errc() ? end : nullptr;
+#else
+        // strtof needs a terminator, so the token is copied to the stack
+        char token[64];
+        std::size_t length = 0;
+        while (first + length != last && !IsSeparator(first[length]) && !IsSpace(first[length])) {
+            if (length + 1 == sizeof(token)) return nullptr;
+            token[length] = first[length];
+            length++;
+        }
+        token[length] = '\0';
+        char* end = nullptr;
+        out = std::strtof(token, &end);
+        return end == token ? nullptr : first + (end - token);
+#endif
+    }
+
+    char* FormatFloat(char* first, char* last, float value) {
+#if OMNIX_FLOAT_CHARCONV
+        return std::to_chars(first, last, value).ptr;
+#else
+        // Nine significant digits round-trip every float
+        const int written = std::snprintf(first, static_cast<std::size_t>(last - first), "%.9g", value);
+        return first + (written > 0 ? written : 0);
+#endif
+    }
+}
+
+bool ParseFloat3(std::string_view text, float out[3]) {
+    const char* cursor = text.data();
+    const char* last = text.data() + text.size();
+    while (cursor != last && IsSpace(*cursor)) cursor++;
+
+    for (int i = 0; i < 3; i++) {
+        if (i > 0) {
+            const char* start = cursor;
+            while (cursor != last && IsSeparator(*cursor)) cursor++;
+            if (cursor == start) return false;
+        }
+        cursor = ParseFloat(cursor, last, out[i]);
+        if (cursor == nullptr) return false;
+    }
+
+    while (cursor != last && IsSpace(*cursor)) cursor++;
+    return cursor == last;
+}
+
+void FormatFloat3(const float value[3], Float3Text& out) {
+    char* cursor = out.data;
+    char* last = out.data + Float3Text::capacity;
+    for (int i = 0; i < 3; i++) {
+        if (i > 0) {
+            std::memcpy(cursor, ", ", 2);
+            cursor += 2;
+        }
+        cursor = FormatFloat(cursor, last, value[i]);
+    }
+    out.size = static_cast<std::size_t>(cursor - out.data);
+}
@@ -0,0 +1,43 @@
+#include "Geometry.hpp"
+#include <cmath>
+#include "TransformSystem.hpp"
+
+Frustum Frustum::FromMatrix(const float m[16]) {
+    // Row i of the matrix is (m[i], m[4 + i], m[8 + i], m[12 + i])
+    auto row = [m](int i, float out[4]) {
+        out[0] = m[i];
+        out[1] = m[4 + i];
+        out[2] = m[8 + i];
+        out[3] = m[12 + i];
+    };
+    float r0[4], r1[4], r2[4], r3[4];
+    row(0, r0);
+    row(1, r1);
+    row(2, r2);
+    row(3, r3);
+
+    Frustum frustum;
+    for (int k = 0; k < 4; k++) {
+        frustum.planes[0][k] = r3[k] + r0[k];  // left
+        frustum.planes[1][k] = r3[k] - r0[k];  // right
+        frustum.planes[2][k] = r3[k] + r1[k];  // bottom
+        frustum.planes[3][k] = r3[k] - r1[k];  // top
+        frustum.planes[4][k] = r3[k] + r2[k];  // near
+        frustum.planes[5][k] = r3[k] - r2[k];  // far
+    }
+    return frustum;
+}
+
+Aabb EntityBounds(const Position& position, const Rotation* rotation, const Scale& scale) {
+    float half[3] = {0.5f * std::fabs(scale.x), 0.5f * std::fabs(scale.y), 0.5f * std::fabs(scale.z)};
+    if (rotation != nullptr) {
+        // Extent of the rotated box along each world axis: |M| applied to (0.5, 0.5, 0.5)
+        WorldMatrix world;
+        TransformKernels::ComputeScalar(&position, rotation, &scale, 1, &world);
+        for (int axis = 0; axis < 3; axis++) {
+            half[axis] = 0.5f * (std::fabs(world.m[axis]) + std::fabs(world.m[4 + axis]) + std::fabs(world.m[8 + axis]));
+        }
+    }
+    return {{position.x - half[0], position.y - half[1], position.z - half[2]},
+            {position.x + half[0], position.y + half[1], position.z + half[2]}};
+}
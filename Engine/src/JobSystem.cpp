@@ -0,0 +1,97 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+
+static thread_local std::size_t currentWorker = 0;
+
+std::size_t JobSystem::DefaultWorkerCount() {
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 1;
+}
+
+std::size_t JobSystem::CurrentWorker() {
+    return currentWorker;
+}
+
+JobSystem::JobSystem(std::size_t workerCount) {
+    workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back([this, i] { WorkerLoop(i + 1); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void JobSystem::Submit(Counter& counter, std::function<void()> job) {
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back({std::move(job), &counter});
+    }
+    queueReady.notify_one();
+}
+
+void JobSystem::Wait(Counter& counter) {
+    while (!counter.Done()) {
+        if (!TryRunOne(counter)) std::this_thread::yield();
+    }
+}
+
+void JobSystem::ParallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (count == 0) return;
+
+    // Aim for a few chunks per thread so uneven chunks still balance out
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t target = ThreadCount() * 4;
+    const std::size_t chunk = std::max(grain, (count + target - 1) / target);
+    if (chunk >= count) {
+        fn(0, count);
+        return;
+    }
+
+    Counter counter;
+    for (std::size_t begin = chunk; begin < count; begin += chunk) {
+        const std::size_t end = std::min(count, begin + chunk);
+        Submit(counter, [&fn, begin, end] { fn(begin, end); });
+    }
+    fn(0, chunk);
+    Wait(counter);
+}
+
+bool JobSystem::TryRunOne(const Counter& counter) {
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        const auto found = std::find_if(queue.begin(), queue.end(), [&counter](const Job& queued) {
+            return queued.counter == &counter;
+        });
+        if (found == queue.end()) return false;
+        job = std::move(*found);
+        queue.erase(found);
+    }
+    job.fn();
+    job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void JobSystem::WorkerLoop(std::size_t index) {
+    currentWorker = index;
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        job.fn();
+        job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
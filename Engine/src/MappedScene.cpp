@@ -0,0 +1,76 @@
+#include "MappedScene.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include "Status.hpp"
+
+MappedScene::MappedScene(MappedScene&& other) noexcept
+    : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)),
+      open(std::exchange(other.open, false)), sections(std::move(other.sections)) {}
+
+MappedScene& MappedScene::operator=(MappedScene&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+        open = std::exchange(other.open, false);
+        sections = std::move(other.sections);
+    }
+    return *this;
+}
+
+bool MappedScene::Open(const std::string& path) {
+    Close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        Status::SetError("Failed to open scene: " + path);
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        Status::SetError("Failed to read scene: " + path);
+        return false;
+    }
+
+    // mmap rejects zero lengths; an empty file is simply an empty scene
+    if (info.st_size > 0) {
+        void* mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            Status::SetError("Failed to map scene: " + path);
+            return false;
+        }
+        data = static_cast<const unsigned char*>(mapping);
+        size = static_cast<std::size_t>(info.st_size);
+    }
+    // The mapping keeps the file alive
+    ::close(fd);
+
+    if (!SceneSnapshot::ParseSections(data, size, sections)) {
+        Close();
+        Status::SetError("Scene file is corrupt or from an incompatible version: " + path);
+        return false;
+    }
+    open = true;
+    return true;
+}
+
+void MappedScene::Close() {
+    if (data != nullptr) ::munmap(const_cast<unsigned char*>(data), size);
+    data = nullptr;
+    size = 0;
+    open = false;
+    sections.clear();
+}
+
+bool MappedScene::Instantiate(entt::registry& registry, NameTable* names) const {
+    if (!open) return false;
+    // Every array is read front to back exactly once; let the kernel read ahead
+    if (data != nullptr) ::posix_madvise(const_cast<unsigned char*>(data), size, POSIX_MADV_SEQUENTIAL);
+    return SceneSnapshot::Instantiate(registry, names, sections);
+}
@@ -0,0 +1,141 @@
+#include "NameTable.hpp"
+#include <cstring>
+
+static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+static constexpr std::size_t minCapacity = 64;
+
+static std::uint32_t HashName(std::string_view name) {
+    return entt::hashed_string::value(name.data(), name.size());
+}
+
+static std::uint32_t EntityIndex(entt::entity entity) {
+    return static_cast<std::uint32_t>(entt::to_entity(entity));
+}
+
+std::size_t NameTable::FindSlot(std::string_view name, std::uint32_t hash) const {
+    if (slots.empty()) return npos;
+
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+        const Slot& slot = slots[i];
+        if (slot.state == SlotState::Empty) return npos;
+        if (slot.state == SlotState::Live && slot.hash == hash && slot.length == name.size()
+            && std::memcmp(arena.data() + slot.offset, name.data(), name.size()) == 0) {
+            return i;
+        }
+    }
+}
+
+bool NameTable::Insert(std::string_view name, entt::entity entity) {
+    if (name.empty() || entity == entt::null) return false;
+
+    const std::uint32_t index = EntityIndex(entity);
+    if (index < slotOfEntity.size() && slotOfEntity[index] != 0) {
+        if (slots[slotOfEntity[index] - 1].entity == entity) return false;
+        // Another version of this index, destroyed without Erase: its name is free again
+        EraseSlot(slotOfEntity[index] - 1);
+    }
+
+    const std::uint32_t hash = HashName(name);
+    if (FindSlot(name, hash) != npos) return false;
+
+    // Keep the load factor (live + tombstones) under 3/4
+    if ((count + tombstones + 1) * 4 > slots.size() * 3) {
+        // Grow when mostly live, otherwise rehash in place to flush tombstones
+        if (slots.empty()) Rehash(minCapacity);
+        else Rehash((count + 1) * 2 > slots.size() ? slots.size() * 2 : slots.size());
+    }
+
+    Slot slot;
+    slot.hash = hash;
+    slot.offset = static_cast<std::uint32_t>(arena.size());
+    slot.length = static_cast<std::uint32_t>(name.size());
+    slot.entity = entity;
+    slot.state = SlotState::Live;
+    arena.insert(arena.end(), name.begin(), name.end());
+
+    const std::size_t mask = slots.size() - 1;
+    std::size_t i = hash & mask;
+    while (slots[i].state == SlotState::Live) i = (i + 1) & mask;
+    if (slots[i].state == SlotState::Erased) --tombstones;
+    slots[i] = slot;
+
+    if (index >= slotOfEntity.size()) slotOfEntity.resize(index + 1, 0);
+    slotOfEntity[index] = static_cast<std::uint32_t>(i + 1);
+    ++count;
+    return true;
+}
+
+entt::entity NameTable::Find(std::string_view name) const {
+    const std::size_t i = FindSlot(name, HashName(name));
+    return i == npos ? entt::entity{entt::null} : slots[i].entity;
+}
+
+std::string_view NameTable::NameOf(entt::entity entity) const {
+    if (entity == entt::null) return {};
+    const std::uint32_t index = EntityIndex(entity);
+    if (index >= slotOfEntity.size() || slotOfEntity[index] == 0) return {};
+
+    const Slot& slot = slots[slotOfEntity[index] - 1];
+    if (slot.state != SlotState::Live || slot.entity != entity) return {};
+    return std::string_view(arena.data() + slot.offset, slot.length);
+}
+
+void NameTable::Erase(entt::entity entity) {
+    if (entity == entt::null) return;
+    const std::uint32_t index = EntityIndex(entity);
+    if (index >= slotOfEntity.size() || slotOfEntity[index] == 0) return;
+
+    const Slot& slot = slots[slotOfEntity[index] - 1];
+    if (slot.state != SlotState::Live || slot.entity != entity) return;
+    EraseSlot(slotOfEntity[index] - 1);
+}
+
+void NameTable::EraseSlot(std::size_t i) {
+    Slot& slot = slots[i];
+    deadBytes += slot.length;
+    slot.state = SlotState::Erased;
+    slotOfEntity[EntityIndex(slot.entity)] = 0;
+    --count;
+    ++tombstones;
+
+    if (deadBytes > minCapacity && deadBytes * 2 > arena.size()) CompactArena();
+}
+
+void NameTable::Clear() {
+    slots.clear();
+    arena.clear();
+    slotOfEntity.clear();
+    count = 0;
+    tombstones = 0;
+    deadBytes = 0;
+}
+
+void NameTable::Rehash(std::size_t capacity) {
+    std::vector<Slot> old;
+    old.swap(slots);
+    slots.assign(capacity, Slot{});
+    tombstones = 0;
+
+    const std::size_t mask = capacity - 1;
+    for (const Slot& slot : old) {
+        if (slot.state != SlotState::Live) continue;
+        std::size_t i = slot.hash & mask;
+        while (slots[i].state != SlotState::Empty) i = (i + 1) & mask;
+        slots[i] = slot;
+        slotOfEntity[EntityIndex(slot.entity)] = static_cast<std::uint32_t>(i + 1);
+    }
+}
+
+void NameTable::CompactArena() {
+    std::vector<char> compacted;
+    compacted.reserve(arena.size() - deadBytes);
+    for (Slot& slot : slots) {
+        if (slot.state != SlotState::Live) continue;
+        const std::uint32_t offset = static_cast<std::uint32_t>(compacted.size());
+        compacted.insert(compacted.end(), arena.begin() + slot.offset, arena.begin() + slot.offset + slot.length);
+        slot.offset = offset;
+    }
+    arena.swap(compacted);
+    deadBytes = 0;
+}
@@ -0,0 +1,30 @@
+#include "Prefab.hpp"
+#include <algorithm>
+
+void Prefab::Instantiate(entt::registry& registry, entt::entity* first, entt::entity* last) const {
+    const auto count = static_cast<std::size_t>(last - first);
+    if (count == 0) return;
+
+    auto& entities = registry.storage<entt::entity>();
+    entities.reserve(entities.size() + count);
+    for (const Entry& entry : entries) {
+        entry.reserve(registry, count);
+    }
+
+    // Fill block by block so the sparse and packed pages of every storage
+    // are still in cache when the next storage is filled
+    for (entt::entity* begin = first; begin != last;) {
+        entt::entity* end = begin + std::min<std::ptrdiff_t>(blockSize, last - begin);
+        registry.create(begin, end);
+        for (const Entry& entry : entries) {
+            entry.fill(registry, begin, end, entry.value);
+        }
+        begin = end;
+    }
+}
+
+std::vector<entt::entity> Prefab::Instantiate(entt::registry& registry, std::size_t count) const {
+    std::vector<entt::entity> entities(count);
+    Instantiate(registry, entities.data(), entities.data() + count);
+    return entities;
+}
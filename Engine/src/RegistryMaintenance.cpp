@@ -0,0 +1,270 @@
+#include "RegistryMaintenance.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+    // Spreads the low 10 bits of v so they occupy every third bit
+    std::uint32_t Spread10(std::uint32_t v) {
+        v &= 0x3ff;
+        v = (v | (v << 16)) & 0x030000ff;
+        v = (v | (v << 8)) & 0x0300f00f;
+        v = (v | (v << 4)) & 0x030c30c3;
+        v = (v | (v << 2)) & 0x09249249;
+        return v;
+    }
+
+    // Group members sort before the rest so they stay at the front of the owned pools
+    constexpr std::uint32_t outsideGroup = std::uint32_t{1} << 30;
+
+    const Position& PositionAt(const entt::storage<Position>& positions, std::size_t index) {
+        constexpr std::size_t page = entt::component_traits<Position>::page_size;
+        return positions.raw()[index / page][index % page];
+    }
+}
+
+RegistryMaintenance::RegistryMaintenance(entt::registry& registry) : registry(registry) {
+    connections.emplace_back(registry.on_construct<Position>().connect<&RegistryMaintenance::OnPositionChange>(*this));
+    connections.emplace_back(registry.on_destroy<Position>().connect<&RegistryMaintenance::OnPositionChange>(*this));
+    connections.emplace_back(registry.on_construct<Transform>().connect<&RegistryMaintenance::OnStructureChange>(*this));
+    connections.emplace_back(registry.on_destroy<Transform>().connect<&RegistryMaintenance::OnStructureChange>(*this));
+    connections.emplace_back(registry.on_construct<Rotation>().connect<&RegistryMaintenance::OnStructureChange>(*this));
+    connections.emplace_back(registry.on_destroy<Rotation>().connect<&RegistryMaintenance::OnStructureChange>(*this));
+    connections.emplace_back(registry.on_construct<Scale>().connect<&RegistryMaintenance::OnStructureChange>(*this));
+    connections.emplace_back(registry.on_destroy<Scale>().connect<&RegistryMaintenance::OnStructureChange>(*this));
+}
+
+void RegistryMaintenance::OnPositionChange(entt::registry&, entt::entity) {
+    churn++;
+    structureChanged = true;
+}
+
+bool RegistryMaintenance::Step(double budgetMs) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(budgetMs);
+    do {
+        if (!Advance()) return false;
+    } while (std::chrono::steady_clock::now() < deadline);
+    return phase != Phase::Idle;
+}
+
+void RegistryMaintenance::Run() {
+    Request();
+    while (Advance()) {}
+}
+
+bool RegistryMaintenance::Advance() {
+    if (phase == Phase::Idle) {
+        if (!requested && (churn == 0 || churn * 8 < registry.storage<Position>().size())) return false;
+        Begin();
+    } else if (structureChanged) {
+        // Sorted keys no longer match the pools
+        Begin();
+    }
+
+    switch (phase) {
+        case Phase::Bounds: StepBounds(); break;
+        case Phase::Keys: StepKeys(); break;
+        case Phase::Sort: StepSort(); break;
+        case Phase::Arrange: StepArrange(); break;
+        case Phase::Follow: StepFollow(); break;
+        case Phase::Shrink: StepShrink(); break;
+        case Phase::Idle: break;
+    }
+    return true;
+}
+
+void RegistryMaintenance::Begin() {
+    const auto& positions = registry.storage<Position>();
+    grouped = registry.owned<Position>();
+    groupSize = grouped ? registry.group<Position, Rotation, Scale>().size() : 0;
+    count = positions.size();
+    keys.resize(count);
+    order.resize(count);
+    scratchKeys.resize(count);
+    scratchOrder.resize(count);
+    std::memset(histogram, 0, sizeof(histogram));
+    for (int axis = 0; axis < 3; axis++) {
+        low[axis] = std::numeric_limits<float>::max();
+        high[axis] = std::numeric_limits<float>::lowest();
+    }
+
+    requested = false;
+    churn = 0;
+    structureChanged = false;
+    cursor = 0;
+    phase = Phase::Bounds;
+}
+
+void RegistryMaintenance::StepBounds() {
+    const auto& positions = registry.storage<Position>();
+    const std::size_t end = std::min(count, cursor + chunk);
+    for (std::size_t i = cursor; i < end; i++) {
+        const Position& p = PositionAt(positions, i);
+        low[0] = std::min(low[0], p.x);
+        low[1] = std::min(low[1], p.y);
+        low[2] = std::min(low[2], p.z);
+        high[0] = std::max(high[0], p.x);
+        high[1] = std::max(high[1], p.y);
+        high[2] = std::max(high[2], p.z);
+    }
+    cursor = end;
+    if (cursor == count) {
+        cursor = 0;
+        phase = Phase::Keys;
+    }
+}
+
+void RegistryMaintenance::StepKeys() {
+    const auto& positions = registry.storage<Position>();
+    float scale[3];
+    for (int axis = 0; axis < 3; axis++) {
+        const float extent = high[axis] - low[axis];
+        scale[axis] = extent > 0.0f ? 1023.0f / extent : 0.0f;
+    }
+
+    const std::size_t end = std::min(count, cursor + chunk);
+    for (std::size_t i = cursor; i < end; i++) {
+        const Position& p = PositionAt(positions, i);
+        // NaN positions land in cell 0
+        const float q[3] = {(p.x - low[0]) * scale[0], (p.y - low[1]) * scale[1], (p.z - low[2]) * scale[2]};
+        std::uint32_t cell[3];
+        for (int axis = 0; axis < 3; axis++) cell[axis] = q[axis] > 0.0f ? static_cast<std::uint32_t>(std::min(q[axis], 1023.0f)) : 0;
+
+        std::uint32_t key = Spread10(cell[0]) | (Spread10(cell[1]) << 1) | (Spread10(cell[2]) << 2);
+        if (grouped && i >= groupSize) key |= outsideGroup;
+        keys[i] = key;
+        order[i] = positions.data()[i];
+        for (int pass = 0; pass < radixPasses; pass++) histogram[pass][(key >> (pass * radixBits)) & (buckets - 1)]++;
+    }
+    cursor = end;
+    if (cursor == count) {
+        cursor = 0;
+        radixPass = 0;
+        phase = Phase::Sort;
+    }
+}
+
+void RegistryMaintenance::StepSort() {
+    if (cursor == 0) {
+        // A digit every key shares does not reorder anything
+        while (radixPass < radixPasses && count != 0) {
+            const std::size_t* counts = histogram[radixPass];
+            if (std::find(counts, counts + buckets, count) == counts + buckets) break;
+            radixPass++;
+        }
+        if (radixPass == radixPasses || count == 0) {
+            phase = Phase::Arrange;
+            return;
+        }
+        std::size_t sum = 0;
+        for (std::size_t b = 0; b < buckets; b++) {
+            offsets[b] = sum;
+            sum += histogram[radixPass][b];
+        }
+    }
+
+    // Chunks are scattered in order, so each pass stays stable
+    const int shift = radixPass * radixBits;
+    const std::size_t end = std::min(count, cursor + chunk);
+    for (std::size_t i = cursor; i < end; i++) {
+        const std::size_t target = offsets[(keys[i] >> shift) & (buckets - 1)]++;
+        scratchKeys[target] = keys[i];
+        scratchOrder[target] = order[i];
+    }
+    cursor = end;
+    if (cursor == count) {
+        keys.swap(scratchKeys);
+        order.swap(scratchOrder);
+        cursor = 0;
+        radixPass++;
+    }
+}
+
+void RegistryMaintenance::StepArrange() {
+    auto& positions = registry.storage<Position>();
+    auto& rotations = registry.storage<Rotation>();
+    auto& scales = registry.storage<Scale>();
+
+    bool moved = false;
+    const std::size_t end = std::min(count, cursor + chunk);
+    for (std::size_t i = cursor; i < end; i++) {
+        const entt::entity current = positions.data()[i];
+        const entt::entity wanted = order[i];
+        if (current == wanted) continue;
+        // Group members share their index in all three owned pools
+        positions.swap_elements(current, wanted);
+        if (i < groupSize) {
+            rotations.swap_elements(current, wanted);
+            scales.swap_elements(current, wanted);
+        }
+        moved = true;
+    }
+    if (moved) generation++;
+
+    cursor = end;
+    if (cursor == count) {
+        cursor = 0;
+        phase = Phase::Follow;
+    }
+}
+
+void RegistryMaintenance::StepFollow() {
+    const auto& positions = registry.storage<Position>();
+    if (cursor == 0) {
+        // Pools owned by the group already moved with Position
+        followers = 0;
+        if (!registry.owned<Transform>()) follow[followers++] = {&registry.storage<Transform>(), 0};
+        if (!registry.owned<Rotation>()) follow[followers++] = {&registry.storage<Rotation>(), 0};
+        if (!registry.owned<Scale>()) follow[followers++] = {&registry.storage<Scale>(), 0};
+    }
+
+    // Walks Position's order and pulls each entity to the next free index of every follower
+    bool moved = false;
+    const std::size_t end = std::min(count, cursor + chunk);
+    for (std::size_t i = cursor; i < end; i++) {
+        const entt::entity entity = positions.data()[i];
+        for (std::size_t k = 0; k < followers; k++) {
+            Follower& follower = follow[k];
+            if (!follower.pool->contains(entity)) continue;
+            const entt::entity current = follower.pool->data()[follower.next++];
+            if (current == entity) continue;
+            follower.pool->swap_elements(current, entity);
+            moved = true;
+        }
+    }
+    if (moved) generation++;
+
+    cursor = end;
+    if (cursor == count) {
+        cursor = 0;
+        phase = Phase::Shrink;
+    }
+}
+
+template<typename Component>
+void RegistryMaintenance::Shrink() {
+    auto& pool = registry.storage<Component>();
+    const std::size_t capacity = pool.capacity();
+    // Drained to under half of what it once held; a page of slack is not worth a reallocation
+    if (capacity - pool.size() < entt::component_traits<Component>::page_size || pool.size() * 2 > capacity) return;
+    pool.shrink_to_fit();
+    releasedBytes += (capacity - pool.capacity()) * (sizeof(Component) + sizeof(entt::entity));
+}
+
+void RegistryMaintenance::StepShrink() {
+    Shrink<Position>();
+    Shrink<Transform>();
+    Shrink<Rotation>();
+    Shrink<Scale>();
+
+    // Keys only matter during a pass
+    keys = {};
+    scratchKeys = {};
+    order = {};
+    scratchOrder = {};
+
+    passes++;
+    phase = Phase::Idle;
+}
@@ -0,0 +1,375 @@
+#include "SceneSnapshot.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include "Status.hpp"
+
+namespace SceneSnapshot {
+
+    namespace {
+
+        std::size_t AlignUp(std::size_t bytes) {
+            return (bytes + alignment - 1) & ~(alignment - 1);
+        }
+
+        // Receives entt::snapshot calls and lays each storage out as one
+        // entity array plus one component array, written in place.
+        class OutputArchive {
+        public:
+            explicit OutputArchive(std::vector<unsigned char>& out) : out(out) {}
+
+            void Begin(std::uint32_t id, std::uint32_t elementSize) {
+                sectionStart = out.size();
+                header = SectionHeader{id, elementSize, 0, 0, 0, 0};
+                counts = 0;
+                out.resize(sectionStart + sizeof(SectionHeader));
+            }
+
+            // First call is the element count, the second (entity section only) the free list
+            void operator()(std::uint32_t value) {
+                if (counts++ != 0) {
+                    header.extra = value;
+                    return;
+                }
+                header.count = value;
+                header.payloadBytes = static_cast<std::uint64_t>(value) * header.elementSize;
+                entityCursor = out.size();
+                componentCursor = entityCursor + AlignUp(value * sizeof(entt::entity));
+                out.resize(componentCursor + AlignUp(header.payloadBytes));
+            }
+
+            void operator()(entt::entity entity) {
+                std::memcpy(out.data() + entityCursor, &entity, sizeof(entity));
+                entityCursor += sizeof(entity);
+            }
+
+            template<typename Component>
+            void operator()(const Component& component) {
+                static_assert(std::is_trivially_copyable_v<Component>, "Scene components must be trivially copyable");
+                std::memcpy(out.data() + componentCursor, &component, sizeof(Component));
+                componentCursor += sizeof(Component);
+            }
+
+            void End() {
+                std::memcpy(out.data() + sectionStart, &header, sizeof(header));
+                sections++;
+            }
+
+            std::uint32_t Sections() const { return sections; }
+
+        private:
+            std::vector<unsigned char>& out;
+            SectionHeader header{};
+            std::size_t sectionStart = 0;
+            std::size_t entityCursor = 0;
+            std::size_t componentCursor = 0;
+            std::uint32_t counts = 0;
+            std::uint32_t sections = 0;
+        };
+
+        // Feeds the entity section to entt::snapshot_loader, which restores
+        // identifiers, versions and the free list exactly as saved
+        class EntityArchive {
+        public:
+            explicit EntityArchive(const Section& section) : section(section), entities(section.entities) {}
+
+            void operator()(std::uint32_t& value) {
+                value = counts++ == 0 ? section.header.count : section.header.extra;
+            }
+
+            void operator()(entt::entity& entity) {
+                std::memcpy(&entity, entities, sizeof(entity));
+                entities += sizeof(entity);
+            }
+
+        private:
+            const Section& section;
+            const unsigned char* entities;
+            std::uint32_t counts = 0;
+        };
+
+        template<typename... Component>
+        void WriteComponents(entt::type_list<Component...>, const entt::snapshot& snapshot, OutputArchive& archive) {
+            ((archive.Begin(SectionId<Component>(), sizeof(Component)),
+              snapshot.get<Component>(archive),
+              archive.End()), ...);
+        }
+
+        // Inserts a whole component array with one storage insert. Returns
+        // false for a known component whose layout no longer matches.
+        template<typename... Component>
+        bool InsertComponents(entt::type_list<Component...>, entt::registry& registry, const Section& section) {
+            bool ok = true;
+            auto insert = [&](auto tag) {
+                using Type = typename decltype(tag)::type;
+                if (section.header.id != SectionId<Type>()) return;
+                if (section.header.elementSize != sizeof(Type)) {
+                    ok = false;
+                    return;
+                }
+
+                const auto* first = reinterpret_cast<const entt::entity*>(section.entities);
+                const auto* last = first + section.header.count;
+                auto& storage = registry.storage<Type>();
+                for (const entt::entity* it = first; it != last; ++it) {
+                    if (!registry.valid(*it) || storage.contains(*it)) {
+                        ok = false;
+                        return;
+                    }
+                }
+                storage.reserve(storage.size() + section.header.count);
+                storage.insert(first, last, reinterpret_cast<const Type*>(section.payload));
+            };
+            (insert(entt::type_identity<Component>{}), ...);
+            return ok;
+        }
+
+        // Position of a section's component in SceneComponents and the element
+        // size InsertComponents() expects, or -1 if the component is unknown
+        template<typename... Component>
+        int KnownComponent(entt::type_list<Component...>, std::uint32_t id, std::uint32_t& elementSize) {
+            static_assert(sizeof...(Component) <= 32, "Validate() keeps one bit per scene component");
+            int position = 0;
+            int found = -1;
+            auto match = [&](auto tag) {
+                using Type = typename decltype(tag)::type;
+                if (id == SectionId<Type>()) {
+                    found = position;
+                    elementSize = sizeof(Type);
+                }
+                position++;
+            };
+            (match(entt::type_identity<Component>{}), ...);
+            return found;
+        }
+
+        void WriteNames(const NameTable& names, std::vector<unsigned char>& out) {
+            std::size_t nameBytes = 0;
+            names.Each([&](entt::entity, std::string_view name) { nameBytes += name.size(); });
+
+            SectionHeader header{nameSectionId, 0, static_cast<std::uint32_t>(names.Size()), 0, 0, 0};
+            header.payloadBytes = names.Size() * sizeof(std::uint32_t) + nameBytes;
+
+            const std::size_t start = out.size();
+            std::size_t entityCursor = start + sizeof(SectionHeader);
+            std::size_t lengthCursor = entityCursor + AlignUp(header.count * sizeof(entt::entity));
+            std::size_t byteCursor = lengthCursor + header.count * sizeof(std::uint32_t);
+            out.resize(lengthCursor + AlignUp(header.payloadBytes));
+            std::memcpy(out.data() + start, &header, sizeof(header));
+
+            names.Each([&](entt::entity entity, std::string_view name) {
+                const auto length = static_cast<std::uint32_t>(name.size());
+                std::memcpy(out.data() + entityCursor, &entity, sizeof(entity));
+                std::memcpy(out.data() + lengthCursor, &length, sizeof(length));
+                std::memcpy(out.data() + byteCursor, name.data(), name.size());
+                entityCursor += sizeof(entity);
+                lengthCursor += sizeof(length);
+                byteCursor += name.size();
+            });
+        }
+
+        bool ReadNames(NameTable& names, const Section& section) {
+            const unsigned char* lengths = section.payload;
+            const unsigned char* bytes = lengths + section.header.count * sizeof(std::uint32_t);
+            const unsigned char* end = lengths + section.header.payloadBytes;
+
+            for (std::uint32_t i = 0; i < section.header.count; i++) {
+                entt::entity entity;
+                std::uint32_t length;
+                std::memcpy(&entity, section.entities + i * sizeof(entity), sizeof(entity));
+                std::memcpy(&length, lengths + i * sizeof(length), sizeof(length));
+                if (length > static_cast<std::size_t>(end - bytes)) return false;
+                names.Insert(std::string_view(reinterpret_cast<const char*>(bytes), length), entity);
+                bytes += length;
+            }
+            return true;
+        }
+    }
+
+    void Write(const entt::registry& registry, const NameTable* names, std::vector<unsigned char>& out) {
+        out.clear();
+        out.resize(sizeof(FileHeader));
+
+        entt::snapshot snapshot{registry};
+        OutputArchive archive(out);
+        archive.Begin(entitySectionId, 0);
+        snapshot.get<entt::entity>(archive);
+        archive.End();
+        WriteComponents(SceneComponents{}, snapshot, archive);
+
+        std::uint32_t sections = archive.Sections();
+        if (names != nullptr) {
+            WriteNames(*names, out);
+            sections++;
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.sectionCount = sections;
+        std::memcpy(out.data(), &header, sizeof(header));
+    }
+
+    bool ParseSections(const unsigned char* data, std::size_t size, std::vector<Section>& out) {
+        out.clear();
+        // An empty file is an empty scene (the project templates ship one)
+        if (size == 0) return true;
+
+        FileHeader header;
+        if (size < sizeof(header)) return false;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version) return false;
+
+        out.reserve(header.sectionCount);
+        std::size_t offset = sizeof(header);
+        for (std::uint32_t s = 0; s < header.sectionCount; s++) {
+            Section section;
+            if (sizeof(SectionHeader) > size - offset) return false;
+            std::memcpy(&section.header, data + offset, sizeof(SectionHeader));
+            offset += sizeof(SectionHeader);
+
+            const SectionHeader& info = section.header;
+            if (info.payloadBytes > size) return false;
+            if (info.elementSize != 0 && info.payloadBytes != std::uint64_t{info.count} * info.elementSize) return false;
+            if (info.id == nameSectionId && info.count * sizeof(std::uint32_t) > info.payloadBytes) return false;
+
+            const std::size_t entityBytes = AlignUp(info.count * sizeof(entt::entity));
+            const std::size_t arrayBytes = entityBytes + AlignUp(info.payloadBytes);
+            if (arrayBytes > size - offset) return false;
+
+            section.entities = data + offset;
+            section.payload = data + offset + entityBytes;
+            out.push_back(section);
+            offset += arrayBytes;
+        }
+        return true;
+    }
+
+    bool Validate(const std::vector<Section>& sections) {
+        // What the loader will make valid: the live rows of the entity section,
+        // each with its version, by entity index
+        std::vector<entt::entity> live;
+        for (const Section& section : sections) {
+            if (section.header.id != entitySectionId) continue;
+            const std::uint32_t count = std::min(section.header.extra, section.header.count);
+            for (std::uint32_t i = 0; i < count; i++) {
+                entt::entity entity;
+                std::memcpy(&entity, section.entities + i * sizeof(entity), sizeof(entity));
+                const std::size_t index = entt::to_entity(entity);
+                if (index >= live.size()) live.resize(index + 1, entt::null);
+                live[index] = entity;
+            }
+        }
+
+        // Component rows must name live entities, each at most once per storage
+        std::vector<std::uint32_t> components(live.size(), 0);
+        for (const Section& section : sections) {
+            const SectionHeader& header = section.header;
+            if (header.id == entitySectionId) continue;
+            if (header.id == nameSectionId) {
+                std::uint64_t bytes = 0;
+                for (std::uint32_t i = 0; i < header.count; i++) {
+                    std::uint32_t length;
+                    std::memcpy(&length, section.payload + i * sizeof(length), sizeof(length));
+                    bytes += length;
+                }
+                if (bytes > header.payloadBytes - header.count * sizeof(std::uint32_t)) return false;
+                continue;
+            }
+
+            std::uint32_t elementSize = 0;
+            const int component = KnownComponent(SceneComponents{}, header.id, elementSize);
+            if (component < 0) continue;
+            if (header.elementSize != elementSize) return false;
+            const std::uint32_t bit = 1u << component;
+            for (std::uint32_t i = 0; i < header.count; i++) {
+                entt::entity entity;
+                std::memcpy(&entity, section.entities + i * sizeof(entity), sizeof(entity));
+                const std::size_t index = entt::to_entity(entity);
+                if (index >= live.size() || live[index] != entity || (components[index] & bit) != 0) return false;
+                components[index] |= bit;
+            }
+        }
+        return true;
+    }
+
+    bool Instantiate(entt::registry& registry, NameTable* names, const std::vector<Section>& sections) {
+        for (const Section& section : sections) {
+            if (section.header.id != entitySectionId) continue;
+            EntityArchive archive(section);
+            entt::snapshot_loader{registry}.get<entt::entity>(archive);
+        }
+
+        for (const Section& section : sections) {
+            if (section.header.id == entitySectionId) continue;
+            if (section.header.id == nameSectionId) {
+                if (names != nullptr && !ReadNames(*names, section)) return false;
+            } else if (!InsertComponents(SceneComponents{}, registry, section)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Read(entt::registry& registry, NameTable* names, const unsigned char* data, std::size_t size) {
+        std::vector<Section> sections;
+        return ParseSections(data, size, sections) && Instantiate(registry, names, sections);
+    }
+
+    bool Save(const entt::registry& registry, const NameTable* names, const std::string& path) {
+        std::vector<unsigned char> buffer;
+        Write(registry, names, buffer);
+
+        // Written next to the target and renamed over it, so a failed or
+        // interrupted save leaves the previous scene intact (and a scene that
+        // is still mapped by a loader keeps its old contents)
+        const std::string temporary = path + ".tmp";
+        std::FILE* file = std::fopen(temporary.c_str(), "wb");
+        if (file == nullptr) {
+            Status::SetError("Failed to open scene for writing: " + path);
+            return false;
+        }
+        bool written = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+        written = std::fflush(file) == 0 && written;
+        written = std::fclose(file) == 0 && written;
+
+        if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            Status::SetError("Failed to write scene: " + path);
+            return false;
+        }
+        Status::SetSuccess("Scene saved: " + path);
+        return true;
+    }
+
+    bool Load(entt::registry& registry, NameTable* names, const std::string& path) {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            Status::SetError("Failed to open scene: " + path);
+            return false;
+        }
+
+        // One read for the whole file
+        std::vector<unsigned char> buffer;
+        std::fseek(file, 0, SEEK_END);
+        const long length = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+        if (length > 0) {
+            buffer.resize(static_cast<std::size_t>(length));
+            if (std::fread(buffer.data(), 1, buffer.size(), file) != buffer.size()) buffer.clear();
+        }
+        std::fclose(file);
+
+        if (length > 0 && buffer.empty()) {
+            Status::SetError("Failed to read scene: " + path);
+            return false;
+        }
+        if (!Read(registry, names, buffer.data(), buffer.size())) {
+            Status::SetError("Scene file is corrupt or from an incompatible version: " + path);
+            return false;
+        }
+        Status::SetSuccess("Scene loaded: " + path);
+        return true;
+    }
+}
@@ -0,0 +1,229 @@
+#include "SceneStreamer.hpp"
+#include <algorithm>
+#include <cstring>
+#include "Status.hpp"
+#include "ecs.hpp"
+
+namespace {
+
+    template<typename Component>
+    bool InsertRows(entt::registry& registry, const entt::entity* entities, const unsigned char* payload, std::size_t count) {
+        auto& storage = registry.storage<Component>();
+        for (std::size_t i = 0; i < count; i++) {
+            if (!registry.valid(entities[i]) || storage.contains(entities[i])) return false;
+        }
+        storage.insert(entities, entities + count, reinterpret_cast<const Component*>(payload));
+        return true;
+    }
+
+    using InsertFn = bool (*)(entt::registry&, const entt::entity*, const unsigned char*, std::size_t);
+
+    // Insert function for a section's component type, or nullptr if unknown or resized
+    template<typename... Component>
+    InsertFn InsertFor(entt::type_list<Component...>, const SceneSnapshot::SectionHeader& header) {
+        InsertFn insert = nullptr;
+        auto match = [&](auto tag) {
+            using Type = typename decltype(tag)::type;
+            if (header.id == SceneSnapshot::SectionId<Type>() && header.elementSize == sizeof(Type)) insert = &InsertRows<Type>;
+        };
+        (match(entt::type_identity<Component>{}), ...);
+        return insert;
+    }
+}
+
+SceneStreamer::SceneStreamer(JobSystem& jobs, std::size_t batchRows) : jobs(jobs), batchRows(batchRows) {}
+
+SceneStreamer::~SceneStreamer() {
+    Cancel();
+}
+
+bool SceneStreamer::Begin(entt::registry& target, NameTable* targetNames, const std::string& scenePath) {
+    Cancel();
+    if (!scene.Open(scenePath)) return false;
+
+    target.clear();
+    if (targetNames != nullptr) targetNames->Clear();
+    registry = &target;
+    names = targetNames;
+    path = scenePath;
+    cancelled.store(false, std::memory_order_relaxed);
+    submitted = inserted = rowsInserted = rowsTotal = 0;
+    reportedTenths = 0;
+    started = std::chrono::steady_clock::now();
+
+    // Entities first so every component batch finds its owners alive. The
+    // snapshot stores the entity storage in packed order, live entities
+    // first, so the first `extra` rows are the ones to restore.
+    for (const SceneSnapshot::Section& section : scene.Sections()) {
+        if (section.header.id != SceneSnapshot::entitySectionId) continue;
+        AddBatches(Kind::Entities, nullptr, section, 0, std::min(section.header.extra, section.header.count));
+    }
+    for (const SceneSnapshot::Section& section : scene.Sections()) {
+        if (section.header.id == SceneSnapshot::entitySectionId) continue;
+        if (section.header.id == SceneSnapshot::nameSectionId) {
+            if (names != nullptr) AddBatches(Kind::Names, nullptr, section, 0, section.header.count);
+        } else if (InsertFn insert = InsertFor(SceneComponents{}, section.header)) {
+            AddBatches(Kind::Components, insert, section, 0, section.header.count);
+        }
+    }
+
+    Status::SetPending("Streaming scene: " + path);
+    SubmitAhead();
+    return true;
+}
+
+void SceneStreamer::AddBatches(Kind kind, InsertFn insert, const SceneSnapshot::Section& section, std::size_t first, std::size_t last) {
+    // Name rows are variable length: one pass over the lengths gives every
+    // batch its byte range, so decoding never rescans earlier rows
+    std::size_t textOffset = 0;
+    for (std::size_t row = 0; kind == Kind::Names && row < first; row++) {
+        std::uint32_t length;
+        std::memcpy(&length, section.payload + row * sizeof(length), sizeof(length));
+        textOffset += length;
+    }
+
+    for (std::size_t begin = first; begin < last; begin += batchRows) {
+        auto batch = std::make_unique<Batch>();
+        batch->kind = kind;
+        batch->insert = insert;
+        batch->section = &section;
+        batch->begin = begin;
+        batch->count = std::min(batchRows, last - begin);
+        if (kind == Kind::Names) {
+            batch->textOffset = textOffset;
+            for (std::size_t row = begin; row < begin + batch->count; row++) {
+                std::uint32_t length;
+                std::memcpy(&length, section.payload + row * sizeof(length), sizeof(length));
+                batch->textBytes += length;
+            }
+            textOffset += batch->textBytes;
+        }
+        rowsTotal += batch->count;
+        batches.push_back(std::move(batch));
+    }
+}
+
+void SceneStreamer::SubmitAhead() {
+    // Keep a few batches per thread in flight so decoded data never piles up
+    const std::size_t window = jobs.ThreadCount() * 2;
+    while (submitted < batches.size() && submitted - inserted < window) {
+        Batch* batch = batches[submitted++].get();
+        jobs.Submit(pending, [this, batch] { Decode(*batch); });
+    }
+}
+
+void SceneStreamer::Decode(Batch& batch) {
+    if (cancelled.load(std::memory_order_relaxed)) return;
+
+    const SceneSnapshot::SectionHeader& header = batch.section->header;
+    const std::size_t entityBytes = batch.count * sizeof(entt::entity);
+    const unsigned char* entities = batch.section->entities + batch.begin * sizeof(entt::entity);
+
+    if (batch.kind == Kind::Names) {
+        const unsigned char* lengths = batch.section->payload;
+        const std::size_t textStart = header.count * sizeof(std::uint32_t);
+        // Lengths that run past the section leave no text, so Insert rejects the batch
+        std::size_t bytes = batch.textBytes;
+        if (batch.textOffset > header.payloadBytes - textStart || bytes > header.payloadBytes - textStart - batch.textOffset) bytes = 0;
+        const unsigned char* text = lengths + textStart + (bytes == 0 ? 0 : batch.textOffset);
+
+        batch.data.resize(entityBytes + batch.count * sizeof(std::uint32_t) + bytes);
+        std::memcpy(batch.data.data(), entities, entityBytes);
+        std::memcpy(batch.data.data() + entityBytes, lengths + batch.begin * sizeof(std::uint32_t), batch.count * sizeof(std::uint32_t));
+        std::memcpy(batch.data.data() + entityBytes + batch.count * sizeof(std::uint32_t), text, bytes);
+    } else {
+        const std::size_t payloadBytes = batch.count * header.elementSize;
+        batch.data.resize(entityBytes + payloadBytes);
+        std::memcpy(batch.data.data(), entities, entityBytes);
+        std::memcpy(batch.data.data() + entityBytes, batch.section->payload + batch.begin * header.elementSize, payloadBytes);
+    }
+    batch.ready.store(true, std::memory_order_release);
+}
+
+bool SceneStreamer::Insert(const Batch& batch) {
+    const auto* entities = reinterpret_cast<const entt::entity*>(batch.data.data());
+    const unsigned char* payload = batch.data.data() + batch.count * sizeof(entt::entity);
+
+    switch (batch.kind) {
+    case Kind::Entities: {
+        auto& storage = registry->storage<entt::entity>();
+        for (std::size_t i = 0; i < batch.count; i++) {
+            if (storage.generate(entities[i]) != entities[i]) return false;
+        }
+        return true;
+    }
+    case Kind::Components:
+        return batch.insert(*registry, entities, payload, batch.count);
+    case Kind::Names: {
+        const unsigned char* text = payload + batch.count * sizeof(std::uint32_t);
+        const unsigned char* end = batch.data.data() + batch.data.size();
+        for (std::size_t i = 0; i < batch.count; i++) {
+            std::uint32_t length;
+            std::memcpy(&length, payload + i * sizeof(length), sizeof(length));
+            if (length > static_cast<std::size_t>(end - text)) return false;
+            names->Insert(std::string_view(reinterpret_cast<const char*>(text), length), entities[i]);
+            text += length;
+        }
+        return true;
+    }
+    }
+    return false;
+}
+
+bool SceneStreamer::Pump(double budgetMs) {
+    if (registry == nullptr) return false;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(budgetMs);
+    while (inserted < submitted && batches[inserted]->ready.load(std::memory_order_acquire)) {
+        Batch& batch = *batches[inserted];
+        if (!Insert(batch)) {
+            Status::SetError("Scene file is corrupt: " + path);
+            Cancel();
+            return false;
+        }
+        rowsInserted += batch.count;
+        batch.data = {};
+        inserted++;
+        SubmitAhead();
+        if (std::chrono::steady_clock::now() >= deadline) break;
+    }
+
+    if (inserted == batches.size()) {
+        Finish();
+        return false;
+    }
+
+    const int tenths = static_cast<int>(Progress() * 10.0f);
+    if (tenths > reportedTenths) {
+        reportedTenths = tenths;
+        Status::Log(Status::LogType::Pending, "Streaming scene: {}%", tenths * 10);
+    }
+    return true;
+}
+
+void SceneStreamer::Finish() {
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    const std::size_t entities = registry->storage<entt::entity>().free_list();
+    Status::Log(Status::LogType::Success, "Scene loaded: {} ({} entities in {} ms)", path, entities,
+                static_cast<int>(seconds * 1000.0));
+    jobs.Wait(pending);
+    batches.clear();
+    scene.Close();
+    registry = nullptr;
+    names = nullptr;
+}
+
+void SceneStreamer::Cancel() {
+    if (registry == nullptr) return;
+    cancelled.store(true, std::memory_order_relaxed);
+    jobs.Wait(pending);
+    batches.clear();
+    scene.Close();
+    registry = nullptr;
+    names = nullptr;
+}
+
+float SceneStreamer::Progress() const {
+    if (rowsTotal == 0) return registry == nullptr ? 1.0f : 0.0f;
+    return static_cast<float>(rowsInserted) / static_cast<float>(rowsTotal);
+}
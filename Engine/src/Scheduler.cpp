@@ -0,0 +1,80 @@
+#include "Scheduler.hpp"
+#include <algorithm>
+#include <chrono>
+
+static bool Intersects(const std::vector<entt::id_type>& a, const std::vector<entt::id_type>& b) {
+    for (const entt::id_type id : a) {
+        if (std::find(b.begin(), b.end(), id) != b.end()) return true;
+    }
+    return false;
+}
+
+Scheduler::Scheduler(entt::registry& registry, JobSystem& jobs, SystemProfiler* profiler)
+    : registry(registry), jobs(jobs), profiler(profiler), commands(jobs.ThreadCount()) {}
+
+void Scheduler::AddSystem(System system) {
+    if (profiler != nullptr) system.profileId = profiler->Register(system.name);
+    systems.push_back(std::move(system));
+    stagesDirty = true;
+}
+
+bool Scheduler::Conflicts(const System& a, const System& b) {
+    return Intersects(a.writes, b.writes) || Intersects(a.writes, b.reads) || Intersects(a.reads, b.writes);
+}
+
+void Scheduler::BuildStages() {
+    // Place each system in the first stage after every earlier system it conflicts with
+    stages.clear();
+    std::vector<std::size_t> stageOf(systems.size(), 0);
+    for (std::size_t i = 0; i < systems.size(); i++) {
+        std::size_t stage = 0;
+        for (std::size_t j = 0; j < i; j++) {
+            if (Conflicts(systems[i], systems[j])) stage = std::max(stage, stageOf[j] + 1);
+        }
+        stageOf[i] = stage;
+        if (stage >= stages.size()) stages.resize(stage + 1);
+        stages[stage].push_back(i);
+    }
+    stagesDirty = false;
+}
+
+std::size_t Scheduler::StageCount() {
+    if (stagesDirty) BuildStages();
+    return stages.size();
+}
+
+void Scheduler::RunSystem(std::size_t index) {
+    SystemContext context(registry, jobs, commands, index);
+    CommandBuffer& buffer = commands.Local();
+    const std::uint64_t previous = buffer.BeginBatch(context.BatchKey(0));
+    const auto start = std::chrono::steady_clock::now();
+    systems[index].fn(context);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    buffer.BeginBatch(previous);
+
+    if (profiler != nullptr) {
+        profiler->Record({systems[index].profileId, static_cast<std::uint32_t>(JobSystem::CurrentWorker()), frame,
+                          static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                          context.Visited()});
+    }
+}
+
+void Scheduler::Run() {
+    if (stagesDirty) BuildStages();
+
+    for (const std::vector<std::size_t>& stage : stages) {
+        JobSystem::Counter counter;
+        for (std::size_t k = 1; k < stage.size(); k++) {
+            const std::size_t index = stage[k];
+            jobs.Submit(counter, [this, index] { RunSystem(index); });
+        }
+
+        // The calling thread takes the first system of the stage itself
+        RunSystem(stage.front());
+        jobs.Wait(counter);
+    }
+
+    // Frame sync point
+    commands.Playback(registry);
+    frame++;
+}
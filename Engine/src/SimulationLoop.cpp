@@ -0,0 +1,158 @@
+#include "SimulationLoop.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    std::int64_t NowNanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    float Lerp(float a, float b, float t) {
+        return a + (b - a) * t;
+    }
+
+    // Euler angles in degrees take the short way round
+    float LerpAngle(float a, float b, float t) {
+        const float delta = std::fmod(std::fmod(b - a, 360.0f) + 540.0f, 360.0f) - 180.0f;
+        return a + delta * t;
+    }
+}
+
+SimulationLoop::SimulationLoop(entt::registry& registry, double ticksPerSecond)
+    : registry(registry),
+      stepSeconds(1.0 / ticksPerSecond),
+      stepDuration(std::chrono::nanoseconds(static_cast<std::int64_t>(1e9 / ticksPerSecond))) {}
+
+SimulationLoop::~SimulationLoop() {
+    Stop();
+}
+
+void SimulationLoop::Start() {
+    if (thread.joinable()) return;
+    running.store(true, std::memory_order_release);
+    thread = std::thread([this] { Run(); });
+}
+
+void SimulationLoop::Stop() {
+    if (!thread.joinable()) return;
+    running.store(false, std::memory_order_release);
+    thread.join();
+}
+
+void SimulationLoop::Run() {
+    auto next = Clock::now();
+    while (running.load(std::memory_order_acquire)) {
+        const auto now = Clock::now();
+        // After a long stall (debugger, huge tick) skip ahead instead of replaying every missed tick
+        if (now - next > stepDuration * maxCatchUpSteps) next = now;
+        while (next <= now) {
+            RunTick(std::chrono::duration_cast<std::chrono::nanoseconds>(next.time_since_epoch()).count());
+            next += stepDuration;
+        }
+        // Spare time is only worth handing out if a good part of the step is left
+        const auto spare = next - Clock::now();
+        if (idle && spare > stepDuration / 4) {
+            std::lock_guard<std::mutex> world(worldMutex);
+            idle(std::chrono::duration<double, std::milli>(spare).count() / 2.0);
+        }
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void SimulationLoop::RunTick(std::int64_t dueNanoseconds) {
+    // Vectors in the slot keep their capacity: no allocations once warmed up
+    SimulationState& state = states.Back();
+    {
+        std::lock_guard<std::mutex> world(worldMutex);
+        if (step) step(stepSeconds);
+        Capture(state);
+    }
+    state.tick = ticks.fetch_add(1, std::memory_order_relaxed) + 1;
+    state.dueNanoseconds = dueNanoseconds;
+    states.Publish();
+}
+
+void SimulationLoop::Capture(SimulationState& state) {
+    auto view = registry.view<Position, Rotation, Scale>();
+    state.entities.clear();
+    state.positions.clear();
+    state.rotations.clear();
+    state.scales.clear();
+    for (auto [entity, position, rotation, scale] : view.each()) {
+        state.entities.push_back(entity);
+        state.positions.push_back(position);
+        state.rotations.push_back(rotation);
+        state.scales.push_back(scale);
+    }
+}
+
+bool SimulationLoop::Interpolate(std::vector<WorldMatrix>& out) {
+    // Without a new tick the pinned pair stays put and keeps blending towards its latest state
+    states.Acquire();
+    const SimulationState* latest = states.Latest();
+    if (latest == nullptr) {
+        out.clear();
+        return false;
+    }
+    const SimulationState& to = *latest;
+
+    const std::size_t count = to.entities.size();
+    out.resize(count);
+    const SimulationState* previous = states.Previous();
+    if (previous == nullptr || previous->dueNanoseconds >= to.dueNanoseconds) {
+        TransformKernels::Compute(to.positions.data(), to.rotations.data(), to.scales.data(), count, out.data());
+        return true;
+    }
+
+    const SimulationState& from = *previous;
+
+    // Drawing one tick behind keeps the target time between the two states
+    const std::int64_t target = NowNanoseconds() - stepDuration.count();
+    const float t = static_cast<float>(std::clamp(
+        static_cast<double>(target - from.dueNanoseconds) / static_cast<double>(to.dueNanoseconds - from.dueNanoseconds), 0.0, 1.0));
+
+    // Same entities in the same order unless something was created or destroyed in between
+    const bool sameOrder = from.entities == to.entities;
+    if (!sameOrder) {
+        previousIndex.assign(previousIndex.size(), UINT32_MAX);
+        for (std::size_t j = 0; j < from.entities.size(); j++) {
+            const std::size_t index = entt::to_entity(from.entities[j]);
+            if (index >= previousIndex.size()) previousIndex.resize(index + 1, UINT32_MAX);
+            previousIndex[index] = static_cast<std::uint32_t>(j);
+        }
+    }
+
+    blendedPositions.resize(count);
+    blendedRotations.resize(count);
+    blendedScales.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        std::size_t j = i;
+        if (!sameOrder) {
+            const std::size_t index = entt::to_entity(to.entities[i]);
+            j = index < previousIndex.size() ? previousIndex[index] : UINT32_MAX;
+            // New since the previous tick, or a recycled index: nothing to blend from
+            if (j == UINT32_MAX || from.entities[j] != to.entities[i]) {
+                blendedPositions[i] = to.positions[i];
+                blendedRotations[i] = to.rotations[i];
+                blendedScales[i] = to.scales[i];
+                continue;
+            }
+        }
+
+        const Position& p0 = from.positions[j];
+        const Position& p1 = to.positions[i];
+        const Rotation& r0 = from.rotations[j];
+        const Rotation& r1 = to.rotations[i];
+        const Scale& s0 = from.scales[j];
+        const Scale& s1 = to.scales[i];
+        blendedPositions[i] = Position(Lerp(p0.x, p1.x, t), Lerp(p0.y, p1.y, t), Lerp(p0.z, p1.z, t));
+        blendedRotations[i] = Rotation(LerpAngle(r0.x, r1.x, t), LerpAngle(r0.y, r1.y, t), LerpAngle(r0.z, r1.z, t));
+        blendedScales[i] = Scale(Lerp(s0.x, s1.x, t), Lerp(s0.y, s1.y, t), Lerp(s0.z, s1.z, t));
+    }
+
+    TransformKernels::Compute(blendedPositions.data(), blendedRotations.data(), blendedScales.data(), count, out.data());
+    return true;
+}
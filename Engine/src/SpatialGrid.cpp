@@ -0,0 +1,135 @@
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <utility>
+#include "ecs.hpp"
+
+SpatialGrid::SpatialGrid(entt::registry& registry, float cellSize)
+    : registry(registry), cellSize(cellSize) {}
+
+void SpatialGrid::Rebuild(JobSystem* jobs) {
+    const auto& storage = registry.storage<Position>();
+    const std::size_t count = storage.size();
+
+    // About one bucket per entity
+    std::uint32_t bits = 10;
+    while ((std::size_t{1} << bits) < count && bits < 24) bits++;
+    bucketMask = (1u << bits) - 1;
+    bucketStart.resize(bucketMask + 2);
+    builtCellSize = cellSize;
+    items.resize(count);
+    if (count == 0) {
+        std::fill(bucketStart.begin(), bucketStart.end(), 0u);
+        return;
+    }
+    scratch.resize(count);
+    keys.resize(count);
+    sortedKeys.resize(count);
+
+    // Fixed chunks, so each radix pass scatters exactly the ranges it counted
+    constexpr std::size_t grain = 16384;
+    const std::size_t chunkCount = jobs == nullptr ? 1 : std::clamp<std::size_t>((count + grain - 1) / grain, 1, jobs->ThreadCount() * 4);
+    const std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    auto forChunks = [&](auto&& fn) {
+        auto run = [&](std::size_t chunk) { fn(chunk, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize)); };
+        if (chunkCount == 1) {
+            run(0);
+            return;
+        }
+        jobs->ParallelFor(chunkCount, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t chunk = begin; chunk < end; chunk++) run(chunk);
+        });
+    };
+
+    // Position storage is paged; index i lives at raw()[i / pageSize][i % pageSize]
+    constexpr std::size_t pageSize = entt::component_traits<Position>::page_size;
+    const entt::entity* entities = storage.data();
+    const auto* pages = storage.raw();
+    const float inverseSize = 1.0f / builtCellSize;
+
+    forChunks([&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const Position& p = pages[i / pageSize][i % pageSize];
+            Item& item = scratch[i];
+            item = {{p.x, p.y, p.z}, {CellOf(p.x, inverseSize), CellOf(p.y, inverseSize), CellOf(p.z, inverseSize)}, entities[i]};
+            keys[i] = Hash(item.cell[0], item.cell[1], item.cell[2]) & bucketMask;
+        }
+    });
+
+    // LSD radix sort of the items by bucket. The items travel with their keys,
+    // so the scatters stream into a few hundred runs instead of gathering at random.
+    constexpr std::uint32_t digitBits = 10;
+    constexpr std::uint32_t radix = 1u << digitBits;
+    histograms.resize(chunkCount * radix);
+    std::uint32_t* sourceKeys = keys.data();
+    std::uint32_t* targetKeys = sortedKeys.data();
+    Item* source = scratch.data();
+    Item* target = items.data();
+    for (std::uint32_t shift = 0; shift < bits; shift += digitBits) {
+        forChunks([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            std::uint32_t* histogram = &histograms[chunk * radix];
+            std::fill(histogram, histogram + radix, 0u);
+            for (std::size_t i = begin; i < end; i++) histogram[(sourceKeys[i] >> shift) & (radix - 1)]++;
+        });
+
+        // Digit-major, chunk-minor offsets keep the sort stable
+        std::uint32_t offset = 0;
+        for (std::uint32_t digit = 0; digit < radix; digit++) {
+            for (std::size_t chunk = 0; chunk < chunkCount; chunk++) {
+                const std::uint32_t n = histograms[chunk * radix + digit];
+                histograms[chunk * radix + digit] = offset;
+                offset += n;
+            }
+        }
+
+        forChunks([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            std::uint32_t* histogram = &histograms[chunk * radix];
+            for (std::size_t i = begin; i < end; i++) {
+                const std::uint32_t position = histogram[(sourceKeys[i] >> shift) & (radix - 1)]++;
+                targetKeys[position] = sourceKeys[i];
+                target[position] = source[i];
+            }
+        });
+        std::swap(sourceKeys, targetKeys);
+        std::swap(source, target);
+    }
+    if (source != items.data()) items.swap(scratch);
+
+    // The first item of each bucket also writes the start of every empty bucket before it
+    forChunks([&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const std::uint32_t bucket = sourceKeys[i];
+            const std::uint32_t first = i == 0 ? 0 : sourceKeys[i - 1] + 1;
+            for (std::uint32_t b = first; b <= bucket; b++) bucketStart[b] = static_cast<std::uint32_t>(i);
+            if (i == count - 1) {
+                for (std::uint32_t b = bucket + 1; b <= bucketMask + 1; b++) bucketStart[b] = static_cast<std::uint32_t>(count);
+            }
+        }
+    });
+}
+
+bool SpatialGrid::CellRange(const Aabb& box, std::int32_t low[3], std::int32_t high[3]) const {
+    if (items.empty()) return false;
+    const float inverseSize = 1.0f / builtCellSize;
+    for (int axis = 0; axis < 3; axis++) {
+        low[axis] = CellOf(box.min[axis], inverseSize);
+        high[axis] = CellOf(box.max[axis], inverseSize);
+    }
+    return true;
+}
+
+void SpatialGrid::QueryBox(const Aabb& box, std::vector<entt::entity>& out) const {
+    ForEachInBox(box, [&out](const Item& item) { out.push_back(item.entity); });
+}
+
+void SpatialGrid::QueryRadius(const float center[3], float radius, std::vector<entt::entity>& out) const {
+    ForEachNeighbour(center, radius, [&out](const Item& item) { out.push_back(item.entity); });
+}
+
+void SpatialGrid::Neighbours(entt::entity entity, float radius, std::vector<entt::entity>& out) const {
+    const Position* position = registry.try_get<Position>(entity);
+    if (position == nullptr) return;
+    const float center[3] = {position->x, position->y, position->z};
+    ForEachNeighbour(center, radius, [&out, entity](const Item& item) {
+        if (item.entity != entity) out.push_back(item.entity);
+    });
+}
@@ -0,0 +1,546 @@
+#include "SpatialTree.hpp"
+#include <algorithm>
+#include "ecs.hpp"
+
+SpatialTree::SpatialTree(entt::registry& registry, JobSystem* jobs, float margin)
+    : registry(registry), jobs(jobs), margin(margin) {
+    connections.emplace_back(registry.on_construct<Position>().connect<&SpatialTree::OnTouch>(*this));
+    connections.emplace_back(registry.on_construct<Scale>().connect<&SpatialTree::OnTouch>(*this));
+    connections.emplace_back(registry.on_construct<Rotation>().connect<&SpatialTree::OnTouch>(*this));
+    connections.emplace_back(registry.on_destroy<Rotation>().connect<&SpatialTree::OnTouch>(*this));
+    connections.emplace_back(registry.on_destroy<Position>().connect<&SpatialTree::OnRemove>(*this));
+    connections.emplace_back(registry.on_destroy<Scale>().connect<&SpatialTree::OnRemove>(*this));
+    Rebuild();
+}
+
+SpatialTree::~SpatialTree() {
+    if (pendingBuild != nullptr) jobs->Wait(pendingBuild->done);
+}
+
+bool SpatialTree::ComputeBounds(entt::entity entity, Aabb& bounds) const {
+    const Position* position = registry.try_get<Position>(entity);
+    const Scale* scale = registry.try_get<Scale>(entity);
+    if (position == nullptr || scale == nullptr) return false;
+    bounds = EntityBounds(*position, registry.try_get<Rotation>(entity), *scale);
+    return true;
+}
+
+Aabb SpatialTree::Fatten(const Aabb& bounds) const {
+    return {{bounds.min[0] - margin, bounds.min[1] - margin, bounds.min[2] - margin},
+            {bounds.max[0] + margin, bounds.max[1] + margin, bounds.max[2] + margin}};
+}
+
+SpatialTree::Slot& SpatialTree::SlotOf(entt::entity entity) {
+    const auto index = static_cast<std::size_t>(entt::to_entity(entity));
+    if (index >= slots.size()) slots.resize(index + 1);
+    return slots[index];
+}
+
+void SpatialTree::Update(const ChangeTracker& changes, std::uint64_t since) {
+    if (pendingBuild != nullptr && pendingBuild->done.Done()) AdoptBuild();
+
+    changed.clear();
+    changes.ChangedSince<Position>(since, changed);
+    changes.ChangedSince<Rotation>(since, changed);
+    changes.ChangedSince<Scale>(since, changed);
+    changed.insert(changed.end(), touched.begin(), touched.end());
+    touched.clear();
+
+    // Past this many edits a top-down build beats reinserting leaf by leaf
+    if (changed.size() > leafCount / 2 + 1024) {
+        Rebuild();
+        return;
+    }
+    for (const entt::entity entity : changed) Refit(entity);
+
+    // Measuring the cost walks every node, so only do it after enough churn
+    if (pendingBuild == nullptr && reinsertsSinceCheck > std::max<std::size_t>(leafCount / 64, 64)) {
+        reinsertsSinceCheck = 0;
+        if (Quality() > rebuildThreshold) StartBuild();
+    }
+}
+
+void SpatialTree::Refit(entt::entity entity) {
+    Aabb bounds;
+    if (!registry.valid(entity) || !ComputeBounds(entity, bounds)) return;
+
+    Slot& slot = SlotOf(entity);
+    if (slot.entity != entity) {
+        slot.entity = entity;
+        slot.leaf = nullNode;
+    }
+    slot.bounds = bounds;
+
+    if (slot.leaf == nullNode) {
+        const std::int32_t leaf = AllocateNode();
+        nodes[leaf] = {Fatten(bounds), nullNode, nullNode, nullNode, 0, entity};
+        InsertLeaf(leaf);
+        slot.leaf = leaf;
+        leafCount++;
+        if (pendingBuild != nullptr) addedDuringBuild.push_back(entity);
+        return;
+    }
+
+    if (Contains(nodes[slot.leaf].box, bounds)) return;
+    RemoveLeaf(slot.leaf);
+    nodes[slot.leaf].box = Fatten(bounds);
+    InsertLeaf(slot.leaf);
+    reinsertsSinceCheck++;
+}
+
+void SpatialTree::Remove(entt::entity entity) {
+    const auto index = static_cast<std::size_t>(entt::to_entity(entity));
+    if (index >= slots.size()) return;
+    Slot& slot = slots[index];
+    if (slot.entity != entity || slot.leaf == nullNode) return;
+
+    RemoveLeaf(slot.leaf);
+    FreeNode(slot.leaf);
+    slot.leaf = nullNode;
+    slot.entity = entt::null;
+    leafCount--;
+}
+
+std::int32_t SpatialTree::AllocateNode() {
+    if (freeList != nullNode) {
+        const std::int32_t node = freeList;
+        freeList = nodes[node].parent;
+        return node;
+    }
+    nodes.push_back({});
+    return static_cast<std::int32_t>(nodes.size() - 1);
+}
+
+void SpatialTree::FreeNode(std::int32_t node) {
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    nodes[node].entity = entt::null;
+    freeList = node;
+}
+
+void SpatialTree::InsertLeaf(std::int32_t leaf) {
+    if (root == nullNode) {
+        root = leaf;
+        nodes[leaf].parent = nullNode;
+        return;
+    }
+
+    // Descend towards the sibling that adds the least surface area
+    const Aabb leafBox = nodes[leaf].box;
+    std::int32_t index = root;
+    while (nodes[index].left != nullNode) {
+        const Node& node = nodes[index];
+        const float area = SurfaceArea(node.box);
+        const float combined = SurfaceArea(Union(node.box, leafBox));
+        const float cost = 2.0f * combined;
+        const float inheritance = 2.0f * (combined - area);
+
+        auto descendCost = [&](std::int32_t child) {
+            const Node& c = nodes[child];
+            const float grown = SurfaceArea(Union(leafBox, c.box));
+            return (c.left == nullNode ? grown : grown - SurfaceArea(c.box)) + inheritance;
+        };
+        const float leftCost = descendCost(node.left);
+        const float rightCost = descendCost(node.right);
+        if (cost < leftCost && cost < rightCost) break;
+        index = leftCost < rightCost ? node.left : node.right;
+    }
+
+    const std::int32_t sibling = index;
+    const std::int32_t oldParent = nodes[sibling].parent;
+    const std::int32_t newParent = AllocateNode();
+    nodes[newParent] = {Union(leafBox, nodes[sibling].box), oldParent, sibling, leaf, nodes[sibling].height + 1, entt::null};
+
+    if (oldParent == nullNode) {
+        root = newParent;
+    } else if (nodes[oldParent].left == sibling) {
+        nodes[oldParent].left = newParent;
+    } else {
+        nodes[oldParent].right = newParent;
+    }
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    FixUpwards(newParent);
+}
+
+void SpatialTree::RemoveLeaf(std::int32_t leaf) {
+    if (leaf == root) {
+        root = nullNode;
+        return;
+    }
+
+    const std::int32_t parent = nodes[leaf].parent;
+    const std::int32_t grandParent = nodes[parent].parent;
+    const std::int32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    if (grandParent == nullNode) {
+        root = sibling;
+        nodes[sibling].parent = nullNode;
+        FreeNode(parent);
+        return;
+    }
+
+    if (nodes[grandParent].left == parent) {
+        nodes[grandParent].left = sibling;
+    } else {
+        nodes[grandParent].right = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+    FixUpwards(grandParent);
+}
+
+void SpatialTree::FixUpwards(std::int32_t index) {
+    while (index != nullNode) {
+        index = Balance(index);
+        Node& node = nodes[index];
+        node.box = Union(nodes[node.left].box, nodes[node.right].box);
+        node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+        index = node.parent;
+    }
+}
+
+// Rotates a child up when one subtree is more than one level taller; returns the new subtree root
+std::int32_t SpatialTree::Balance(std::int32_t iA) {
+    Node& a = nodes[iA];
+    if (a.left == nullNode || a.height < 2) return iA;
+
+    const std::int32_t iB = a.left;
+    const std::int32_t iC = a.right;
+    Node& b = nodes[iB];
+    Node& c = nodes[iC];
+    const std::int32_t balance = c.height - b.height;
+
+    auto replaceChild = [this](std::int32_t parent, std::int32_t from, std::int32_t to) {
+        if (parent == nullNode) {
+            root = to;
+        } else if (nodes[parent].left == from) {
+            nodes[parent].left = to;
+        } else {
+            nodes[parent].right = to;
+        }
+    };
+
+    if (balance > 1) {
+        const std::int32_t iF = c.left;
+        const std::int32_t iG = c.right;
+        Node& f = nodes[iF];
+        Node& g = nodes[iG];
+
+        c.left = iA;
+        c.parent = a.parent;
+        a.parent = iC;
+        replaceChild(c.parent, iA, iC);
+
+        if (f.height > g.height) {
+            c.right = iF;
+            a.right = iG;
+            g.parent = iA;
+            a.box = Union(b.box, g.box);
+            c.box = Union(a.box, f.box);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        } else {
+            c.right = iG;
+            a.right = iF;
+            f.parent = iA;
+            a.box = Union(b.box, f.box);
+            c.box = Union(a.box, g.box);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+        return iC;
+    }
+
+    if (balance < -1) {
+        const std::int32_t iD = b.left;
+        const std::int32_t iE = b.right;
+        Node& d = nodes[iD];
+        Node& e = nodes[iE];
+
+        b.left = iA;
+        b.parent = a.parent;
+        a.parent = iB;
+        replaceChild(b.parent, iA, iB);
+
+        if (d.height > e.height) {
+            b.right = iD;
+            a.left = iE;
+            e.parent = iA;
+            a.box = Union(c.box, e.box);
+            b.box = Union(a.box, d.box);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        } else {
+            b.right = iE;
+            a.left = iD;
+            d.parent = iA;
+            a.box = Union(c.box, d.box);
+            b.box = Union(a.box, e.box);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+float SpatialTree::Cost() const {
+    if (root == nullNode) return 0.0f;
+    const float rootArea = SurfaceArea(nodes[root].box);
+    if (rootArea <= 0.0f) return 0.0f;
+
+    double total = 0.0;
+    for (const Node& node : nodes) {
+        if (node.height > 0) total += SurfaceArea(node.box);
+    }
+    return static_cast<float>(total / rootArea);
+}
+
+float SpatialTree::Quality() const {
+    return builtCost > 0.0f ? Cost() / builtCost : 1.0f;
+}
+
+void SpatialTree::Rebuild() {
+    if (pendingBuild != nullptr) {
+        jobs->Wait(pendingBuild->done);
+        pendingBuild.reset();
+        addedDuringBuild.clear();
+    }
+
+    for (Slot& slot : slots) {
+        slot.entity = entt::null;
+        slot.leaf = nullNode;
+    }
+
+    std::vector<BuildItem> items;
+    auto view = registry.view<Position, Scale>();
+    items.reserve(view.size_hint());
+    for (const entt::entity entity : view) {
+        Slot& slot = SlotOf(entity);
+        slot.entity = entity;
+        ComputeBounds(entity, slot.bounds);
+        items.push_back({Fatten(slot.bounds), entity});
+    }
+
+    std::vector<Node> built;
+    built.reserve(items.empty() ? 0 : items.size() * 2 - 1);
+    const std::int32_t builtRoot = BuildRange(built, items.data(), items.data() + items.size(), nullNode);
+    Install(std::move(built), builtRoot);
+}
+
+void SpatialTree::CollectItems(std::vector<BuildItem>& items) {
+    items.reserve(leafCount);
+    for (const Node& node : nodes) {
+        if (node.height != 0 || node.entity == entt::null) continue;
+        items.push_back({Fatten(slots[entt::to_entity(node.entity)].bounds), node.entity});
+    }
+}
+
+std::int32_t SpatialTree::BuildRange(std::vector<Node>& nodes, BuildItem* first, BuildItem* last, std::int32_t parent) {
+    if (first == last) return nullNode;
+
+    const auto index = static_cast<std::int32_t>(nodes.size());
+    nodes.push_back({});
+    if (last - first == 1) {
+        nodes[index] = {first->box, parent, nullNode, nullNode, 0, first->entity};
+        return index;
+    }
+
+    // Median split on the axis where the centres spread the most
+    float low[3] = {first->box.min[0] + first->box.max[0], first->box.min[1] + first->box.max[1], first->box.min[2] + first->box.max[2]};
+    float high[3] = {low[0], low[1], low[2]};
+    for (const BuildItem* item = first + 1; item != last; ++item) {
+        for (int axis = 0; axis < 3; axis++) {
+            const float centre = item->box.min[axis] + item->box.max[axis];
+            low[axis] = std::min(low[axis], centre);
+            high[axis] = std::max(high[axis], centre);
+        }
+    }
+    int axis = 0;
+    if (high[1] - low[1] > high[axis] - low[axis]) axis = 1;
+    if (high[2] - low[2] > high[axis] - low[axis]) axis = 2;
+
+    BuildItem* middle = first + (last - first) / 2;
+    std::nth_element(first, middle, last, [axis](const BuildItem& x, const BuildItem& y) {
+        return x.box.min[axis] + x.box.max[axis] < y.box.min[axis] + y.box.max[axis];
+    });
+
+    const std::int32_t left = BuildRange(nodes, first, middle, index);
+    const std::int32_t right = BuildRange(nodes, middle, last, index);
+    nodes[index] = {Union(nodes[left].box, nodes[right].box), parent, left, right,
+                    1 + std::max(nodes[left].height, nodes[right].height), entt::null};
+    return index;
+}
+
+void SpatialTree::Install(std::vector<Node>&& built, std::int32_t builtRoot) {
+    nodes = std::move(built);
+    root = builtRoot;
+    freeList = nullNode;
+    leafCount = 0;
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].height != 0) continue;
+        slots[entt::to_entity(nodes[i].entity)].leaf = static_cast<std::int32_t>(i);
+        leafCount++;
+    }
+    builtCost = Cost();
+    reinsertsSinceCheck = 0;
+}
+
+void SpatialTree::StartBuild() {
+    if (jobs == nullptr) {
+        Rebuild();
+        return;
+    }
+
+    // Bounds are copied now; edits made while the job runs are replayed in AdoptBuild()
+    pendingBuild = std::make_unique<Build>();
+    addedDuringBuild.clear();
+    Build* build = pendingBuild.get();
+    CollectItems(build->items);
+    jobs->Submit(build->done, [build] {
+        build->nodes.reserve(build->items.empty() ? 0 : build->items.size() * 2 - 1);
+        build->root = BuildRange(build->nodes, build->items.data(), build->items.data() + build->items.size(), nullNode);
+    });
+}
+
+void SpatialTree::AdoptBuild() {
+    std::unique_ptr<Build> build = std::move(pendingBuild);
+
+    // Entities indexed during the build are not in the new tree yet
+    for (const entt::entity entity : addedDuringBuild) {
+        Slot& slot = SlotOf(entity);
+        if (slot.entity == entity) slot.leaf = nullNode;
+    }
+
+    // Map live entities onto the new leaves; leaves of entities that were
+    // removed or moved out of their fat box in the meantime are fixed up below
+    std::vector<std::int32_t> stale;
+    std::vector<std::int32_t> moved;
+    for (std::size_t i = 0; i < build->nodes.size(); i++) {
+        const Node& node = build->nodes[i];
+        if (node.height != 0) continue;
+        const auto leaf = static_cast<std::int32_t>(i);
+        Slot& slot = slots[entt::to_entity(node.entity)];
+        if (slot.entity == node.entity && slot.leaf != nullNode) {
+            slot.leaf = leaf;
+            if (!Contains(node.box, slot.bounds)) moved.push_back(leaf);
+        } else {
+            stale.push_back(leaf);
+        }
+    }
+
+    nodes = std::move(build->nodes);
+    root = build->root;
+    freeList = nullNode;
+    leafCount = build->items.size();
+    builtCost = Cost();
+    reinsertsSinceCheck = 0;
+
+    for (const std::int32_t leaf : stale) {
+        RemoveLeaf(leaf);
+        FreeNode(leaf);
+        leafCount--;
+    }
+    for (const std::int32_t leaf : moved) {
+        RemoveLeaf(leaf);
+        nodes[leaf].box = Fatten(slots[entt::to_entity(nodes[leaf].entity)].bounds);
+        InsertLeaf(leaf);
+    }
+    for (const entt::entity entity : addedDuringBuild) Refit(entity);
+    addedDuringBuild.clear();
+}
+
+void SpatialTree::QueryBox(const Aabb& box, std::vector<entt::entity>& out) const {
+    if (root == nullNode) return;
+    std::vector<std::int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(root);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (!Overlaps(node.box, box)) continue;
+        if (node.left == nullNode) {
+            if (Overlaps(slots[entt::to_entity(node.entity)].bounds, box)) out.push_back(node.entity);
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+}
+
+void SpatialTree::QuerySphere(const float center[3], float radius, std::vector<entt::entity>& out) const {
+    if (root == nullNode) return;
+    std::vector<std::int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(root);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (!OverlapsSphere(node.box, center, radius)) continue;
+        if (node.left == nullNode) {
+            if (OverlapsSphere(slots[entt::to_entity(node.entity)].bounds, center, radius)) out.push_back(node.entity);
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+}
+
+void SpatialTree::QueryFrustum(const Frustum& frustum, std::vector<entt::entity>& out) const {
+    if (root == nullNode) return;
+
+    // Second member: the subtree is known to be fully inside, skip the plane tests
+    std::vector<std::pair<std::int32_t, bool>> stack;
+    stack.reserve(64);
+    stack.emplace_back(root, false);
+    while (!stack.empty()) {
+        const auto [index, inside] = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[index];
+        bool accepted = inside;
+        if (!accepted) {
+            if (!frustum.Overlaps(node.box)) continue;
+            accepted = frustum.Contains(node.box);
+        }
+        if (node.left == nullNode) {
+            if (accepted || frustum.Overlaps(slots[entt::to_entity(node.entity)].bounds)) out.push_back(node.entity);
+        } else {
+            stack.emplace_back(node.left, accepted);
+            stack.emplace_back(node.right, accepted);
+        }
+    }
+}
+
+bool SpatialTree::Raycast(const Ray& ray, entt::entity& hit, float& distance) const {
+    if (root == nullNode) return false;
+
+    const float inverse[3] = {1.0f / ray.direction[0], 1.0f / ray.direction[1], 1.0f / ray.direction[2]};
+    float closest = ray.maxDistance;
+    bool found = false;
+
+    std::vector<std::int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(root);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        float entry;
+        if (!IntersectRay(node.box, ray.origin, inverse, closest, entry)) continue;
+        if (node.left == nullNode) {
+            if (IntersectRay(slots[entt::to_entity(node.entity)].bounds, ray.origin, inverse, closest, entry)) {
+                closest = entry;
+                hit = node.entity;
+                found = true;
+            }
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+
+    if (found) distance = closest;
+    return found;
+}
@@ -1,68 +1,346 @@
 #include "Status.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace Status {
 
-    // Internal storage for statuses (for backward compatibility)
-    static std::string loadingStatus;
-    static std::string runtimeStatus;
-    static std::string errorStatus;
-    static std::string warningStatus;
-    static std::string infoStatus;
-    static std::string debugStatus;
-    static std::string traceStatus;
-    static std::string fatalStatus;
-    static std::string unknownStatus;
-    static std::string successStatus;
-    static std::string failureStatus;
-    static std::string pendingStatus;
-    static std::string cancelledStatus;
-
-    // Log history storage
-    static std::vector<LogEntry> logHistory;
-
-    // Helper to add to log history
-    static void AddLog(LogType type, const std::string& message) {
-        if (!message.empty()) {
-            logHistory.push_back({type, message});
+    namespace {
+
+        // Appends one encoded argument; returns where the next one starts, or
+        // nullptr when the record was cut short
+        const char* AppendArgument(std::string& out, const char* in, const char* end) {
+            const char tag = *in++;
+            if (tag == LogArgs::Boolean) {
+                if (in == end) return nullptr;
+                out.append(*in ? "true" : "false");
+                return in + 1;
+            }
+            if (tag == LogArgs::Text) {
+                std::uint32_t length;
+                if (static_cast<std::size_t>(end - in) < sizeof(length)) return nullptr;
+                std::memcpy(&length, in, sizeof(length));
+                in += sizeof(length);
+                if (static_cast<std::size_t>(end - in) < length) return nullptr;
+                out.append(in, length);
+                return in + length;
+            }
+            if (end - in < 8) return nullptr;
+            char text[32];
+            char* last = text;
+            if (tag == LogArgs::Signed) {
+                std::int64_t value;
+                std::memcpy(&value, in, 8);
+                last = std::to_chars(text, text + sizeof(text), value).ptr;
+            } else if (tag == LogArgs::Unsigned) {
+                std::uint64_t value;
+                std::memcpy(&value, in, 8);
+                last = std::to_chars(text, text + sizeof(text), value).ptr;
+            } else if (tag == LogArgs::Floating) {
+                double value;
+                std::memcpy(&value, in, 8);
+                const int written = std::snprintf(text, sizeof(text), "%g", value);
+                last = text + (written > 0 ? written : 0);
+            } else {
+                return nullptr;
+            }
+            out.append(text, last);
+            return in + 8;
+        }
+    }
+
+    void LogEntry::AppendText(std::string& out) const {
+        if (format == nullptr) {
+            out.append(message.data(), message.size());
+            return;
+        }
+        const char* in = message.data();
+        const char* end = in + message.size();
+        const char* cursor = format;
+        while (const char* placeholder = std::strstr(cursor, "{}")) {
+            out.append(cursor, placeholder);
+            cursor = placeholder + 2;
+            // Missing or cut-short arguments keep their placeholder
+            const char* next = in != nullptr && in != end ? AppendArgument(out, in, end) : nullptr;
+            if (next == nullptr) out.append("{}");
+            in = next;
+        }
+        out.append(cursor);
+    }
+
+    std::string_view LogEntry::Text(std::string& scratch) const {
+        if (format == nullptr) return message;
+        scratch.clear();
+        AppendText(scratch);
+        return scratch;
+    }
+
+    LogHistory::LogHistory(std::size_t byteCapacity, std::size_t entryCapacity)
+        : byteCapacity(std::max<std::size_t>(1, std::min<std::size_t>(byteCapacity, UINT32_MAX))) {
+        std::size_t capacity = 1;
+        while (capacity < entryCapacity) capacity <<= 1;
+        recordMask = capacity - 1;
+    }
+
+    void LogHistory::EvictOldest() {
+        const std::size_t t = static_cast<std::size_t>(records[first].type);
+        std::vector<std::uint64_t>& sequences = typeSequences[t];
+        if (++typeFirst[t] >= 1024 && typeFirst[t] * 2 >= sequences.size()) {
+            sequences.erase(sequences.begin(), sequences.begin() + typeFirst[t]);
+            typeFirst[t] = 0;
+        }
+        first = (first + 1) & recordMask;
+        count--;
+        head++;
+        dropped++;
+    }
+
+    void LogHistory::Push(LogType type, std::string_view message, const char* format) {
+        if (bytes.empty()) {
+            bytes.resize(byteCapacity);
+            records.resize(recordMask + 1);
+        }
+        const std::size_t length = std::min(message.size(), byteCapacity);
+        if (count == records.size()) EvictOldest();
+
+        // Messages stay contiguous: one that does not fit before the end of
+        // the ring starts over at 0, and whatever the skipped tail still
+        // held is from the previous lap, so it goes first
+        if (writeOffset + length > byteCapacity) {
+            while (count != 0 && records[first].offset >= writeOffset) EvictOldest();
+            writeOffset = 0;
+        }
+        // The oldest entry is the next one after the write offset
+        while (count != 0) {
+            const Record& oldest = records[first];
+            if (oldest.offset >= writeOffset + length || oldest.offset + oldest.length <= writeOffset) break;
+            EvictOldest();
+        }
+
+        std::copy(message.data(), message.data() + length, bytes.data() + writeOffset);
+        records[(first + count) & recordMask] = {format, static_cast<std::uint32_t>(writeOffset),
+                                                 static_cast<std::uint32_t>(length), type};
+        typeSequences[static_cast<std::size_t>(type)].push_back(head + count);
+        count++;
+        writeOffset += length;
+    }
+
+    void LogHistory::Append(const LogHistory& other) {
+        for (const LogEntry entry : other) Push(entry.type, entry.message, entry.format);
+        dropped += other.dropped;
+    }
+
+    std::size_t LogHistory::FindOf(LogType type, std::uint64_t sequence) const {
+        const std::size_t t = static_cast<std::size_t>(type);
+        const auto begin = typeSequences[t].begin() + typeFirst[t];
+        return static_cast<std::size_t>(std::lower_bound(begin, typeSequences[t].end(), sequence) - begin);
+    }
+
+    void LogHistory::Clear() {
+        head += count;
+        first = 0;
+        count = 0;
+        writeOffset = 0;
+        dropped = 0;
+        for (std::size_t t = 0; t < logTypeCount; t++) {
+            typeSequences[t].clear();
+            typeFirst[t] = 0;
+        }
+    }
+
+    namespace {
+
+        // Bounded multi-producer queue between the logging threads and the
+        // consumer: a slot is free for position p while its sequence equals p
+        // and holds an entry once it reads p + 1. Slot strings keep their
+        // capacity, so once warm a log call copies its text without allocating.
+        struct alignas(64) Slot {
+            std::atomic<std::uint64_t> sequence;
+            LogType type;
+            // Set for Log() records, whose message holds the encoded arguments
+            const char* format;
+            std::string message;
+        };
+
+        constexpr std::size_t ringSize = 4096;
+        constexpr std::uint64_t ringMask = ringSize - 1;
+        static_assert((ringSize & ringMask) == 0, "Ring size must be a power of two");
+
+        struct Pipeline {
+            Pipeline() : slots(std::make_unique<Slot[]>(ringSize)) {
+                for (std::size_t i = 0; i < ringSize; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            std::unique_ptr<Slot[]> slots;
+            alignas(64) std::atomic<std::uint64_t> head{0};
+
+            // Consumer side: whoever holds the lock drains the ring
+            alignas(64) std::mutex consumerMutex;
+            std::uint64_t tail = 0;
+            // Only the thread reading the history (the UI) appends to it; a
+            // producer that finds the ring full drains into spill instead
+            LogHistory logHistory;
+            LogHistory spill;
+            // Latest message per type (for backward compatibility), formatted when read
+            std::string latest[logTypeCount];
+            const char* latestFormat[logTypeCount] = {};
+        };
+
+        Pipeline& Logs() {
+            static Pipeline pipeline;
+            return pipeline;
+        }
+
+        // Moves everything published so far into history; consumerMutex held
+        void DrainLocked(Pipeline& logs, LogHistory& history) {
+            // Find the published range first, so each type's latest message is copied once
+            std::uint64_t end = logs.tail;
+            std::uint64_t last[logTypeCount];
+            std::fill(last, last + logTypeCount, UINT64_MAX);
+            while (logs.slots[end & ringMask].sequence.load(std::memory_order_acquire) == end + 1) {
+                last[static_cast<std::size_t>(logs.slots[end & ringMask].type)] = end;
+                end++;
+            }
+            if (end == logs.tail) return;
+            for (std::size_t type = 0; type < logTypeCount; type++) {
+                if (last[type] == UINT64_MAX) continue;
+                const Slot& slot = logs.slots[last[type] & ringMask];
+                logs.latest[type] = slot.message;
+                logs.latestFormat[type] = slot.format;
+            }
+            for (; logs.tail != end; logs.tail++) {
+                Slot& slot = logs.slots[logs.tail & ringMask];
+                history.Push(slot.type, slot.message, slot.format);
+                slot.sequence.store(logs.tail + ringSize, std::memory_order_release);
+            }
+        }
+
+        // Claims a slot and has fill write the message into it
+        template<typename Fill>
+        void Enqueue(LogType type, const char* format, Fill&& fill) {
+            Pipeline& logs = Logs();
+            std::uint64_t position = logs.head.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = logs.slots[position & ringMask];
+                const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::int64_t>(sequence - position);
+                if (difference == 0) {
+                    if (logs.head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        slot.type = type;
+                        slot.format = format;
+                        fill(slot.message);
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return;
+                    }
+                } else if (difference < 0) {
+                    // Full: nobody drained for a whole ring, so this thread does it rather than drop the entry
+                    if (logs.consumerMutex.try_lock()) {
+                        DrainLocked(logs, logs.spill);
+                        logs.consumerMutex.unlock();
+                    } else {
+                        std::this_thread::yield();
+                    }
+                    position = logs.head.load(std::memory_order_relaxed);
+                } else {
+                    position = logs.head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void Publish(LogType type, std::string_view message) {
+            if (message.empty()) return;
+            Enqueue(type, nullptr, [message](std::string& out) { out.assign(message.data(), message.size()); });
+        }
+
+        // Spilled entries are older than anything still in the ring; consumerMutex held
+        void CollectLocked(Pipeline& logs) {
+            if (!logs.spill.Empty() || logs.spill.Dropped() != 0) {
+                logs.logHistory.Append(logs.spill);
+                logs.spill.Clear();
+            }
+            DrainLocked(logs, logs.logHistory);
+        }
+
+        // Reads and resets the latest message of one type
+        std::string Take(LogType type) {
+            Pipeline& logs = Logs();
+            std::lock_guard<std::mutex> lock(logs.consumerMutex);
+            CollectLocked(logs);
+            std::string& latest = logs.latest[static_cast<std::size_t>(type)];
+            const char*& format = logs.latestFormat[static_cast<std::size_t>(type)];
+            std::string out;
+            if (format == nullptr) {
+                out = std::move(latest);
+            } else {
+                LogEntry{type, latest, format}.AppendText(out);
+                format = nullptr;
+            }
+            latest.clear();
+            return out;
         }
     }
 
     // Setters
-    void SetLoadingStatus(const std::string& s) { loadingStatus = s; AddLog(LogType::Loading, s); }
-    void SetRuntimeStatus(const std::string& s) { runtimeStatus = s; AddLog(LogType::Runtime, s); }
-    void SetError(const std::string& s) { errorStatus = s; AddLog(LogType::Error, s); }
-    void SetWarning(const std::string& s) { warningStatus = s; AddLog(LogType::Warning, s); }
-    void SetInfo(const std::string& s) { infoStatus = s; AddLog(LogType::Info, s); }
-    void SetDebug(const std::string& s) { debugStatus = s; AddLog(LogType::Debug, s); }
-    void SetTrace(const std::string& s) { traceStatus = s; AddLog(LogType::Trace, s); }
-    void SetFatal(const std::string& s) { fatalStatus = s; AddLog(LogType::Fatal, s); }
-    void SetUnknown(const std::string& s) { unknownStatus = s; AddLog(LogType::Unknown, s); }
-    void SetSuccess(const std::string& s) { successStatus = s; AddLog(LogType::Success, s); }
-    void SetFailure(const std::string& s) { failureStatus = s; AddLog(LogType::Failure, s); }
-    void SetPending(const std::string& s) { pendingStatus = s; AddLog(LogType::Pending, s); }
-    void SetCancelled(const std::string& s) { cancelledStatus = s; AddLog(LogType::Cancelled, s); }
+    void SetLoadingStatus(std::string_view s) { Publish(LogType::Loading, s); }
+    void SetRuntimeStatus(std::string_view s) { Publish(LogType::Runtime, s); }
+    void SetError(std::string_view s) { Publish(LogType::Error, s); }
+    void SetWarning(std::string_view s) { Publish(LogType::Warning, s); }
+    void SetInfo(std::string_view s) { Publish(LogType::Info, s); }
+    void SetDebug(std::string_view s) { Publish(LogType::Debug, s); }
+    void SetTrace(std::string_view s) { Publish(LogType::Trace, s); }
+    void SetFatal(std::string_view s) { Publish(LogType::Fatal, s); }
+    void SetUnknown(std::string_view s) { Publish(LogType::Unknown, s); }
+    void SetSuccess(std::string_view s) { Publish(LogType::Success, s); }
+    void SetFailure(std::string_view s) { Publish(LogType::Failure, s); }
+    void SetPending(std::string_view s) { Publish(LogType::Pending, s); }
+    void SetCancelled(std::string_view s) { Publish(LogType::Cancelled, s); }
+
+    void PublishRecord(LogType type, const char* format, std::size_t size, RecordWriter write, const void* arguments) {
+        Enqueue(type, format, [&](std::string& out) {
+            out.resize(size);
+            write(out.data(), arguments);
+        });
+    }
 
     // Getters (for backward compatibility)
-    std::string GetLoadingStatus() { std::string out = loadingStatus; loadingStatus = ""; return out; }
-    std::string GetRuntimeStatus()  { std::string out = runtimeStatus;  runtimeStatus  = ""; return out; }
-    std::string GetError()          { std::string out = errorStatus;    errorStatus    = ""; return out; }
-    std::string GetWarning()        { std::string out = warningStatus;  warningStatus  = ""; return out; }
-    std::string GetInfo()           { std::string out = infoStatus;     infoStatus     = ""; return out; }
-    std::string GetDebug()          { std::string out = debugStatus;    debugStatus    = ""; return out; }
-    std::string GetTrace()          { std::string out = traceStatus;    traceStatus    = ""; return out; }
-    std::string GetFatal()          { std::string out = fatalStatus;    fatalStatus    = ""; return out; }
-    std::string GetUnknown()        { std::string out = unknownStatus;  unknownStatus  = ""; return out; }
-    std::string GetSuccess()        { std::string out = successStatus;  successStatus  = ""; return out; }
-    std::string GetFailure()        { std::string out = failureStatus;  failureStatus  = ""; return out; }
-    std::string GetPending()        { std::string out = pendingStatus;  pendingStatus  = ""; return out; }
-    std::string GetCancelled()      { std::string out = cancelledStatus; cancelledStatus= ""; return out; }
+    std::string GetLoadingStatus() { return Take(LogType::Loading); }
+    std::string GetRuntimeStatus()  { return Take(LogType::Runtime); }
+    std::string GetError()          { return Take(LogType::Error); }
+    std::string GetWarning()        { return Take(LogType::Warning); }
+    std::string GetInfo()           { return Take(LogType::Info); }
+    std::string GetDebug()          { return Take(LogType::Debug); }
+    std::string GetTrace()          { return Take(LogType::Trace); }
+    std::string GetFatal()          { return Take(LogType::Fatal); }
+    std::string GetUnknown()        { return Take(LogType::Unknown); }
+    std::string GetSuccess()        { return Take(LogType::Success); }
+    std::string GetFailure()        { return Take(LogType::Failure); }
+    std::string GetPending()        { return Take(LogType::Pending); }
+    std::string GetCancelled()      { return Take(LogType::Cancelled); }
 
     // New log history functions
-    const std::vector<LogEntry>& GetAllLogs() {
-        return logHistory;
+    void Drain() {
+        Pipeline& logs = Logs();
+        std::lock_guard<std::mutex> lock(logs.consumerMutex);
+        CollectLocked(logs);
+    }
+
+    const LogHistory& GetAllLogs() {
+        Pipeline& logs = Logs();
+        std::lock_guard<std::mutex> lock(logs.consumerMutex);
+        CollectLocked(logs);
+        return logs.logHistory;
     }
 
     void ClearAllLogs() {
-        logHistory.clear();
+        Pipeline& logs = Logs();
+        std::lock_guard<std::mutex> lock(logs.consumerMutex);
+        CollectLocked(logs);
+        logs.logHistory.Clear();
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,115 @@
+#include "SystemProfiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include "Status.hpp"
+
+SystemProfiler::SystemProfiler(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) size *= 2;
+    slots = std::make_unique<Slot[]>(size);
+    for (std::size_t i = 0; i < size; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+    mask = size - 1;
+}
+
+std::uint32_t SystemProfiler::Register(const std::string& name) {
+    systems.push_back({});
+    systems.back().name = name;
+    return static_cast<std::uint32_t>(systems.size() - 1);
+}
+
+bool SystemProfiler::Record(const Sample& sample) {
+    std::uint64_t position = head.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[position & mask];
+        const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::int64_t>(sequence - position);
+        if (difference == 0) {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.sample = sample;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            // The consumer has not caught up with this slot yet
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void SystemProfiler::Drain() {
+    for (;;) {
+        Slot& slot = slots[tail & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1) return;
+        const Sample sample = slot.sample;
+        slot.sequence.store(tail + mask + 1, std::memory_order_release);
+        tail++;
+
+        if (sample.system >= systems.size()) continue;
+        Stats& stats = systems[sample.system];
+        stats.minNanoseconds = stats.runs == 0 ? sample.nanoseconds : std::min(stats.minNanoseconds, sample.nanoseconds);
+        stats.maxNanoseconds = std::max(stats.maxNanoseconds, sample.nanoseconds);
+        stats.runs++;
+        stats.totalNanoseconds += sample.nanoseconds;
+        stats.lastNanoseconds = sample.nanoseconds;
+        stats.totalEntities += sample.entities;
+        stats.lastEntities = sample.entities;
+        stats.lastWorker = sample.worker;
+        stats.lastFrame = sample.frame;
+    }
+}
+
+void SystemProfiler::Reset() {
+    for (Stats& stats : systems) {
+        std::string name = std::move(stats.name);
+        stats = {};
+        stats.name = std::move(name);
+    }
+    dropped.store(0, std::memory_order_relaxed);
+}
+
+bool SystemProfiler::ExportJson(const std::string& path) const {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        Status::SetError("Failed to open profile for writing: " + path);
+        return false;
+    }
+
+    char timestamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"suite\": \"SystemProfiler\",\n");
+    std::fprintf(file, "  \"timestamp\": \"%s\",\n", timestamp);
+    std::fprintf(file, "  \"dropped_samples\": %llu,\n", static_cast<unsigned long long>(Dropped()));
+    std::fprintf(file, "  \"systems\": [\n");
+    for (std::size_t i = 0; i < systems.size(); i++) {
+        const Stats& stats = systems[i];
+        std::string name;
+        for (const char c : stats.name) {
+            if (c == '"' || c == '\\') name += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) name += c;
+        }
+        std::fprintf(file,
+                     "    {\"name\": \"%s\", \"runs\": %llu, \"mean_ms\": %.6f, \"min_ms\": %.6f, \"max_ms\": %.6f, "
+                     "\"total_ms\": %.6f, \"last_ms\": %.6f, \"entities_total\": %llu, \"entities_last\": %llu, "
+                     "\"last_worker\": %u}%s\n",
+                     name.c_str(), static_cast<unsigned long long>(stats.runs), stats.MeanMilliseconds(),
+                     stats.minNanoseconds / 1e6, stats.maxNanoseconds / 1e6, stats.totalNanoseconds / 1e6,
+                     stats.lastNanoseconds / 1e6, static_cast<unsigned long long>(stats.totalEntities),
+                     static_cast<unsigned long long>(stats.lastEntities), stats.lastWorker,
+                     i + 1 < systems.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+
+    if (std::fclose(file) != 0) {
+        Status::SetError("Failed to write profile: " + path);
+        return false;
+    }
+    Status::SetSuccess("System profile exported: " + path);
+    return true;
+}
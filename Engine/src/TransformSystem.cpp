@@ -0,0 +1,332 @@
+#include "TransformSystem.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+static_assert(sizeof(Position) == 3 * sizeof(float), "Position must be three packed floats");
+static_assert(sizeof(Rotation) == 3 * sizeof(float), "Rotation must be three packed floats");
+static_assert(sizeof(Scale) == 3 * sizeof(float), "Scale must be three packed floats");
+
+namespace {
+
+    constexpr float degToRad = 0.01745329251994329577f;
+
+    // Lane wrappers: the wide kernel below is written once against these.
+#if defined(__SSE2__)
+    struct SseLanes {
+        using V = __m128;
+        static constexpr std::size_t width = 4;
+
+        static V Set1(float v) { return _mm_set1_ps(v); }
+        static V Add(V a, V b) { return _mm_add_ps(a, b); }
+        static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+        static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+        static V And(V a, V b) { return _mm_and_ps(a, b); }
+        static V AndNot(V a, V b) { return _mm_andnot_ps(a, b); }
+        static V Or(V a, V b) { return _mm_or_ps(a, b); }
+        static V Xor(V a, V b) { return _mm_xor_ps(a, b); }
+        static V Eq(V a, V b) { return _mm_cmpeq_ps(a, b); }
+        static V Ge(V a, V b) { return _mm_cmpge_ps(a, b); }
+        static V Trunc(V a) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(a)); }
+
+        // Loads one float from each of four consecutive xyz triples
+        static V Gather3(const float* p) { return _mm_setr_ps(p[0], p[3], p[6], p[9]); }
+
+        // e[k] holds matrix element k for every lane
+        static void Store(V (&e)[16], WorldMatrix* out) {
+            for (int col = 0; col < 4; col++) {
+                V r0 = e[col * 4 + 0], r1 = e[col * 4 + 1], r2 = e[col * 4 + 2], r3 = e[col * 4 + 3];
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_storeu_ps(out[0].m + col * 4, r0);
+                _mm_storeu_ps(out[1].m + col * 4, r1);
+                _mm_storeu_ps(out[2].m + col * 4, r2);
+                _mm_storeu_ps(out[3].m + col * 4, r3);
+            }
+        }
+    };
+#endif
+
+#if defined(__AVX__)
+    struct AvxLanes {
+        using V = __m256;
+        static constexpr std::size_t width = 8;
+
+        static V Set1(float v) { return _mm256_set1_ps(v); }
+        static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+        static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+        static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+        static V And(V a, V b) { return _mm256_and_ps(a, b); }
+        static V AndNot(V a, V b) { return _mm256_andnot_ps(a, b); }
+        static V Or(V a, V b) { return _mm256_or_ps(a, b); }
+        static V Xor(V a, V b) { return _mm256_xor_ps(a, b); }
+        static V Eq(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+        static V Ge(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static V Trunc(V a) { return _mm256_round_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+
+        static V Gather3(const float* p) {
+            return _mm256_setr_ps(p[0], p[3], p[6], p[9], p[12], p[15], p[18], p[21]);
+        }
+
+        static void Store(V (&e)[16], WorldMatrix* out) {
+            for (int col = 0; col < 4; col++) {
+                __m128 lo0 = _mm256_castps256_ps128(e[col * 4 + 0]), hi0 = _mm256_extractf128_ps(e[col * 4 + 0], 1);
+                __m128 lo1 = _mm256_castps256_ps128(e[col * 4 + 1]), hi1 = _mm256_extractf128_ps(e[col * 4 + 1], 1);
+                __m128 lo2 = _mm256_castps256_ps128(e[col * 4 + 2]), hi2 = _mm256_extractf128_ps(e[col * 4 + 2], 1);
+                __m128 lo3 = _mm256_castps256_ps128(e[col * 4 + 3]), hi3 = _mm256_extractf128_ps(e[col * 4 + 3], 1);
+                _MM_TRANSPOSE4_PS(lo0, lo1, lo2, lo3);
+                _MM_TRANSPOSE4_PS(hi0, hi1, hi2, hi3);
+                _mm_storeu_ps(out[0].m + col * 4, lo0);
+                _mm_storeu_ps(out[1].m + col * 4, lo1);
+                _mm_storeu_ps(out[2].m + col * 4, lo2);
+                _mm_storeu_ps(out[3].m + col * 4, lo3);
+                _mm_storeu_ps(out[4].m + col * 4, hi0);
+                _mm_storeu_ps(out[5].m + col * 4, hi1);
+                _mm_storeu_ps(out[6].m + col * 4, hi2);
+                _mm_storeu_ps(out[7].m + col * 4, hi3);
+            }
+        }
+    };
+#endif
+
+    // Cephes-style sincosf using float ops only (AVX1 has no 256-bit integer math).
+    // Accurate to a few ulp for |x| up to ~8192 radians.
+    template<typename L>
+    inline void SinCos(typename L::V x, typename L::V& s, typename L::V& c) {
+        using V = typename L::V;
+        const V signMask = L::Set1(-0.0f);
+        V sinSign = L::And(x, signMask);
+        x = L::AndNot(signMask, x);
+
+        // Octant index rounded up to even, then Cody-Waite reduction by pi/4
+        V j = L::Trunc(L::Mul(x, L::Set1(1.27323954473516f)));
+        j = L::Mul(L::Trunc(L::Mul(L::Add(j, L::Set1(1.0f)), L::Set1(0.5f))), L::Set1(2.0f));
+        x = L::Sub(x, L::Mul(j, L::Set1(0.78515625f)));
+        x = L::Sub(x, L::Mul(j, L::Set1(2.4187564849853515625e-4f)));
+        x = L::Sub(x, L::Mul(j, L::Set1(3.77489497744594108e-8f)));
+
+        // j mod 8 is one of 0, 2, 4, 6
+        const V q = L::Sub(j, L::Mul(L::Trunc(L::Mul(j, L::Set1(0.125f))), L::Set1(8.0f)));
+        const V q2 = L::Eq(q, L::Set1(2.0f));
+        const V swap = L::Or(q2, L::Eq(q, L::Set1(6.0f)));
+        sinSign = L::Xor(sinSign, L::And(L::Ge(q, L::Set1(4.0f)), signMask));
+        const V cosSign = L::And(L::Or(q2, L::Eq(q, L::Set1(4.0f))), signMask);
+
+        const V z = L::Mul(x, x);
+        V pc = L::Add(L::Mul(L::Set1(2.443315711809948e-5f), z), L::Set1(-1.388731625493765e-3f));
+        pc = L::Add(L::Mul(pc, z), L::Set1(4.166664568298827e-2f));
+        pc = L::Mul(L::Mul(pc, z), z);
+        pc = L::Add(L::Sub(pc, L::Mul(L::Set1(0.5f), z)), L::Set1(1.0f));
+
+        V ps = L::Add(L::Mul(L::Set1(-1.9515295891e-4f), z), L::Set1(8.3321608736e-3f));
+        ps = L::Add(L::Mul(ps, z), L::Set1(-1.6666654611e-1f));
+        ps = L::Add(L::Mul(L::Mul(ps, z), x), x);
+
+        s = L::Xor(L::Or(L::And(swap, pc), L::AndNot(swap, ps)), sinSign);
+        c = L::Xor(L::Or(L::And(swap, ps), L::AndNot(swap, pc)), cosSign);
+    }
+
+    template<typename L>
+    void ComputeWide(const Position* positions, const Rotation* rotations, const Scale* scales,
+                     std::size_t count, WorldMatrix* out) {
+        using V = typename L::V;
+        const V toRad = L::Set1(degToRad);
+        const V zero = L::Set1(0.0f);
+        const V one = L::Set1(1.0f);
+
+        std::size_t i = 0;
+        for (; i + L::width <= count; i += L::width) {
+            const float* rot = reinterpret_cast<const float*>(rotations + i);
+            const float* scl = reinterpret_cast<const float*>(scales + i);
+            const float* pos = reinterpret_cast<const float*>(positions + i);
+
+            V sa, ca, sb, cb, sc, cc;
+            SinCos<L>(L::Mul(L::Gather3(rot + 0), toRad), sa, ca);
+            SinCos<L>(L::Mul(L::Gather3(rot + 1), toRad), sb, cb);
+            SinCos<L>(L::Mul(L::Gather3(rot + 2), toRad), sc, cc);
+
+            const V sx = L::Gather3(scl + 0);
+            const V sy = L::Gather3(scl + 1);
+            const V sz = L::Gather3(scl + 2);
+            const V sbsa = L::Mul(sb, sa);
+            const V cbsa = L::Mul(cb, sa);
+
+            V e[16];
+            e[0] = L::Mul(L::Add(L::Mul(cb, cc), L::Mul(sbsa, sc)), sx);
+            e[1] = L::Mul(L::Mul(ca, sc), sx);
+            e[2] = L::Mul(L::Sub(L::Mul(cbsa, sc), L::Mul(sb, cc)), sx);
+            e[3] = zero;
+            e[4] = L::Mul(L::Sub(L::Mul(sbsa, cc), L::Mul(cb, sc)), sy);
+            e[5] = L::Mul(L::Mul(ca, cc), sy);
+            e[6] = L::Mul(L::Add(L::Mul(sb, sc), L::Mul(cbsa, cc)), sy);
+            e[7] = zero;
+            e[8] = L::Mul(L::Mul(sb, ca), sz);
+            e[9] = L::Mul(L::Sub(zero, sa), sz);
+            e[10] = L::Mul(L::Mul(cb, ca), sz);
+            e[11] = zero;
+            e[12] = L::Gather3(pos + 0);
+            e[13] = L::Gather3(pos + 1);
+            e[14] = L::Gather3(pos + 2);
+            e[15] = one;
+            L::Store(e, out + i);
+        }
+
+        // Run the tail through the same kernel so a matrix never depends on batch size
+        if (i < count) {
+            Position tailPositions[L::width];
+            Rotation tailRotations[L::width];
+            Scale tailScales[L::width];
+            WorldMatrix tailOut[L::width];
+            std::copy(positions + i, positions + count, tailPositions);
+            std::copy(rotations + i, rotations + count, tailRotations);
+            std::copy(scales + i, scales + count, tailScales);
+            ComputeWide<L>(tailPositions, tailRotations, tailScales, L::width, tailOut);
+            std::copy(tailOut, tailOut + (count - i), out + i);
+        }
+    }
+}
+
+namespace TransformKernels {
+
+    Path ActivePath() {
+#if defined(__AVX__)
+        return Path::AVX;
+#elif defined(__SSE2__)
+        return Path::SSE;
+#else
+        return Path::Scalar;
+#endif
+    }
+
+    const char* PathName(Path path) {
+        switch (path) {
+            case Path::AVX: return "AVX";
+            case Path::SSE: return "SSE";
+            default:        return "Scalar";
+        }
+    }
+
+    void ComputeScalar(const Position* positions, const Rotation* rotations, const Scale* scales,
+                       std::size_t count, WorldMatrix* out) {
+        for (std::size_t i = 0; i < count; i++) {
+            const Position& p = positions[i];
+            const Rotation& r = rotations[i];
+            const Scale& s = scales[i];
+
+            const float sa = std::sin(r.x * degToRad), ca = std::cos(r.x * degToRad);
+            const float sb = std::sin(r.y * degToRad), cb = std::cos(r.y * degToRad);
+            const float sc = std::sin(r.z * degToRad), cc = std::cos(r.z * degToRad);
+
+            float* m = out[i].m;
+            m[0] = (cb * cc + sb * sa * sc) * s.x;
+            m[1] = (ca * sc) * s.x;
+            m[2] = (cb * sa * sc - sb * cc) * s.x;
+            m[3] = 0.0f;
+            m[4] = (sb * sa * cc - cb * sc) * s.y;
+            m[5] = (ca * cc) * s.y;
+            m[6] = (sb * sc + cb * sa * cc) * s.y;
+            m[7] = 0.0f;
+            m[8] = (sb * ca) * s.z;
+            m[9] = -sa * s.z;
+            m[10] = (cb * ca) * s.z;
+            m[11] = 0.0f;
+            m[12] = p.x;
+            m[13] = p.y;
+            m[14] = p.z;
+            m[15] = 1.0f;
+        }
+    }
+
+    void Compute(const Position* positions, const Rotation* rotations, const Scale* scales,
+                 std::size_t count, WorldMatrix* out) {
+#if defined(__AVX__)
+        ComputeWide<AvxLanes>(positions, rotations, scales, count, out);
+#elif defined(__SSE2__)
+        ComputeWide<SseLanes>(positions, rotations, scales, count, out);
+#else
+        ComputeScalar(positions, rotations, scales, count, out);
+#endif
+    }
+}
+
+TransformSystem::TransformSystem(entt::registry& registry) : registry(registry) {
+    // Claim ownership of the three storages up front so they are kept packed
+    registry.group<Position, Rotation, Scale>();
+
+    // Joining or leaving the group reorders the packed arrays
+    connections.emplace_back(registry.on_construct<Position>().connect<&TransformSystem::OnStructureChange>(*this));
+    connections.emplace_back(registry.on_construct<Rotation>().connect<&TransformSystem::OnStructureChange>(*this));
+    connections.emplace_back(registry.on_construct<Scale>().connect<&TransformSystem::OnStructureChange>(*this));
+    connections.emplace_back(registry.on_destroy<Position>().connect<&TransformSystem::OnStructureChange>(*this));
+    connections.emplace_back(registry.on_destroy<Rotation>().connect<&TransformSystem::OnStructureChange>(*this));
+    connections.emplace_back(registry.on_destroy<Scale>().connect<&TransformSystem::OnStructureChange>(*this));
+}
+
+void TransformSystem::Update() {
+    structureChanged = false;
+    fullRebuild = true;
+    updated.clear();
+
+    auto group = registry.group<Position, Rotation, Scale>();
+    const std::size_t count = group.size();
+    matrices.resize(count);
+    entities = count != 0 ? group.handle().data() : nullptr;
+    if (count == 0) return;
+
+    // Owned storages keep group members at the front, in the same order
+    const auto& positions = *group.storage<Position>();
+    const auto& rotations = *group.storage<Rotation>();
+    const auto& scales = *group.storage<Scale>();
+
+    constexpr std::size_t page = entt::component_traits<Position>::page_size;
+    static_assert(page == entt::component_traits<Rotation>::page_size
+                  && page == entt::component_traits<Scale>::page_size, "Owned storages must share a page size");
+
+    for (std::size_t first = 0; first < count; first += page) {
+        const std::size_t index = first / page;
+        TransformKernels::Compute(positions.raw()[index], rotations.raw()[index], scales.raw()[index],
+                                  std::min(page, count - first), matrices.data() + first);
+    }
+}
+
+void TransformSystem::Update(const ChangeTracker& changes, std::uint64_t since) {
+    if (structureChanged) {
+        Update();
+        return;
+    }
+
+    fullRebuild = false;
+    updated.clear();
+    changed.clear();
+    changes.ChangedSince<Position>(since, changed);
+    changes.ChangedSince<Rotation>(since, changed);
+    changes.ChangedSince<Scale>(since, changed);
+    if (changed.empty()) return;
+
+    auto group = registry.group<Position, Rotation, Scale>();
+    const auto& positions = *group.storage<Position>();
+    for (const entt::entity entity : changed) {
+        if (group.contains(entity)) updated.push_back(static_cast<std::uint32_t>(positions.index(entity)));
+    }
+    std::sort(updated.begin(), updated.end());
+    updated.erase(std::unique(updated.begin(), updated.end()), updated.end());
+
+    // Gather the edited rows so the SIMD kernel still runs on contiguous input
+    const std::size_t count = updated.size();
+    scratchPositions.resize(count);
+    scratchRotations.resize(count);
+    scratchScales.resize(count);
+    scratchMatrices.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const entt::entity entity = entities[updated[i]];
+        scratchPositions[i] = group.get<Position>(entity);
+        scratchRotations[i] = group.get<Rotation>(entity);
+        scratchScales[i] = group.get<Scale>(entity);
+    }
+
+    TransformKernels::Compute(scratchPositions.data(), scratchRotations.data(), scratchScales.data(),
+                              count, scratchMatrices.data());
+    for (std::size_t i = 0; i < count; i++) matrices[updated[i]] = scratchMatrices[i];
+}
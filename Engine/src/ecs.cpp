@@ -1,25 +1,259 @@
 #include "ecs.hpp"
+#include "ComponentRegistry.hpp"
+#include "Float3Text.hpp"
+#include "MappedScene.hpp"
+#include "NameTable.hpp"
+#include "Prefab.hpp"
+#include "SceneSnapshot.hpp"
+#include "SceneStreamer.hpp"
+#include "SpatialGrid.hpp"
 #include "Status.hpp"
+#include "SystemProfiler.hpp"
 #include "entt.hpp"
 
-entt::registry registry;
+namespace {
+
+    // Resolves a component name through the ComponentRegistry, logging unknown names
+    const ComponentRegistry::Ops* ResolveComponent(std::string_view componentName) {
+        const ComponentRegistry::Ops* ops = ComponentRegistry::At(ComponentRegistry::Find(componentName));
+        if (ops == nullptr) Status::Log(Status::LogType::Error, "Error: Unknown component {}", componentName);
+        return ops;
+    }
+}
+
+ECS::ECS()
+    : spatialGrid(std::make_unique<SpatialGrid>(registry)),
+      systemProfiler(std::make_unique<SystemProfiler>()) {
+    // Every destroy path (DeleteEntity, command buffer playback, clear) gives the name back
+    registry.on_destroy<entt::entity>().connect<&ECS::OnDestroy>(*this);
+}
+
+ECS::~ECS() {
+    registry.on_destroy<entt::entity>().disconnect<&ECS::OnDestroy>(*this);
+}
+
+void ECS::OnDestroy(entt::registry&, entt::entity entity) {
+    entityNames.Erase(entity);
+}
+
+entt::registry& ECS::Registry() {
+    return registry;
+}
+
+SpatialGrid& ECS::Grid() {
+    return *spatialGrid;
+}
+
+SystemProfiler& ECS::Profiler() {
+    return *systemProfiler;
+}
+
+entt::entity ECS::CreateEntity(std::string_view entityName) {
 
-void ECS::CreateEntity(std::string entityID) {
-    
     const auto entity = registry.create();
     registry.emplace<Position>(entity, 0, 0, 0);
     registry.emplace<Transform>(entity, 0, 0, 0);
     registry.emplace<Rotation>(entity, 0, 0, 0);
     registry.emplace<Scale>(entity, 1, 1, 1);
-    
-    if (registry.valid(entity)) { Status::SetRuntimeStatus("Entity " + entityID + " created");
-    
+
+    if (!registry.valid(entity)) {
+        Status::SetError("Error: Object could not be created");
+        return entt::null;
+    }
+
+    if (!entityName.empty() && !entityNames.Insert(entityName, entity)) {
+        Status::Log(Status::LogType::Warning, "Entity name {} is already in use", entityName);
+    }
+
+    if (entityName.empty()) {
+        Status::SetRuntimeStatus("Entity created");
     } else {
-        if (!registry.valid(entity)) { Status::SetError("Error: Object could not be created");
-            return;
-        }
+        Status::Log(Status::LogType::Runtime, "Entity {} created", entityName);
+    }
+    return entity;
+}
+
+void ECS::CreateEntities(entt::entity* first, entt::entity* last, const Position& position,
+                         const Rotation& rotation, const Scale& scale) {
+    const auto count = static_cast<std::size_t>(last - first);
+    if (count == 0) return;
+
+    auto& entities = registry.storage<entt::entity>();
+    auto& positions = registry.storage<Position>();
+    auto& transforms = registry.storage<Transform>();
+    auto& rotations = registry.storage<Rotation>();
+    auto& scales = registry.storage<Scale>();
+
+    entities.reserve(entities.size() + count);
+    positions.reserve(positions.size() + count);
+    transforms.reserve(transforms.size() + count);
+    rotations.reserve(rotations.size() + count);
+    scales.reserve(scales.size() + count);
+
+    registry.create(first, last);
+    positions.insert(first, last, position);
+    transforms.insert(first, last, Transform{});
+    rotations.insert(first, last, rotation);
+    scales.insert(first, last, scale);
+
+    Status::Log(Status::LogType::Runtime, "{} entities created", count);
+}
+
+std::vector<entt::entity> ECS::CreateEntities(std::size_t count, const Position& position,
+                                              const Rotation& rotation, const Scale& scale) {
+    std::vector<entt::entity> entities(count);
+    CreateEntities(entities.data(), entities.data() + count, position, rotation, scale);
+    return entities;
+}
+
+std::vector<entt::entity> ECS::Instantiate(const Prefab& prefab, std::size_t count) {
+    std::vector<entt::entity> entities = prefab.Instantiate(registry, count);
+    Status::Log(Status::LogType::Runtime, "{} prefab instances created", count);
+    return entities;
+}
+
+void ECS::DeleteEntity(entt::entity entity) {
+    if (!registry.valid(entity)) {
+        Status::SetError("Error: Cannot delete invalid entity");
+        return;
+    }
+
+    registry.destroy(entity);
+}
+
+bool ECS::IsValid(entt::entity entity) {
+    return registry.valid(entity);
+}
+
+entt::entity ECS::FindEntity(std::string_view entityName) const {
+    return entityNames.Find(entityName);
+}
+
+std::string_view ECS::GetEntityName(entt::entity entity) const {
+    return entityNames.NameOf(entity);
+}
+
+bool ECS::SetEntityName(entt::entity entity, std::string_view entityName) {
+    if (!registry.valid(entity)) return false;
+
+    const entt::entity owner = entityNames.Find(entityName);
+    if (owner == entity) return true;
+    if (owner != entt::null) {
+        Status::Log(Status::LogType::Warning, "Entity name {} is already in use", entityName);
+        return false;
+    }
+
+    entityNames.Erase(entity);
+    return entityName.empty() || entityNames.Insert(entityName, entity);
+}
+
+ComponentId ECS::FindComponent(std::string_view componentName) const {
+    return ComponentRegistry::Find(componentName);
+}
+
+bool ECS::AddComponent(entt::entity entity, ComponentId component) {
+    const ComponentRegistry::Ops* ops = ComponentRegistry::At(component);
+    if (ops == nullptr || !registry.valid(entity)) return false;
+    ops->add(registry, entity);
+    return true;
+}
+
+bool ECS::RemoveComponent(entt::entity entity, ComponentId component) {
+    const ComponentRegistry::Ops* ops = ComponentRegistry::At(component);
+    if (ops == nullptr || !registry.valid(entity)) return false;
+    ops->remove(registry, entity);
+    return true;
+}
+
+bool ECS::HasComponent(entt::entity entity, ComponentId component) {
+    const ComponentRegistry::Ops* ops = ComponentRegistry::At(component);
+    return ops != nullptr && registry.valid(entity) && ops->has(registry, entity);
+}
+
+bool ECS::GetComponentValue(entt::entity entity, ComponentId component, float out[3]) {
+    const ComponentRegistry::Ops* ops = ComponentRegistry::At(component);
+    return ops != nullptr && registry.valid(entity) && ops->get(registry, entity, out);
+}
+
+bool ECS::SetComponentValue(entt::entity entity, ComponentId component, const float value[3]) {
+    const ComponentRegistry::Ops* ops = ComponentRegistry::At(component);
+    return ops != nullptr && registry.valid(entity) && ops->set(registry, entity, value);
+}
+
+bool ECS::AddComponent(entt::entity entity, std::string_view componentName) {
+    if (!registry.valid(entity)) return false;
+    const ComponentRegistry::Ops* ops = ResolveComponent(componentName);
+    if (ops == nullptr) return false;
+    ops->add(registry, entity);
+    return true;
+}
+
+bool ECS::RemoveComponent(entt::entity entity, std::string_view componentName) {
+    if (!registry.valid(entity)) return false;
+    const ComponentRegistry::Ops* ops = ResolveComponent(componentName);
+    if (ops == nullptr) return false;
+    ops->remove(registry, entity);
+    return true;
+}
+
+bool ECS::HasComponent(entt::entity entity, std::string_view componentName) {
+    if (!registry.valid(entity)) return false;
+    const ComponentRegistry::Ops* ops = ResolveComponent(componentName);
+    return ops != nullptr && ops->has(registry, entity);
+}
+
+std::string ECS::GetComponentValue(entt::entity entity, std::string_view componentName) {
+    Float3Text text;
+    if (!GetComponentValue(entity, componentName, text)) return {};
+    return std::string(text.View());
+}
+
+bool ECS::GetComponentValue(entt::entity entity, std::string_view componentName, Float3Text& out) {
+    if (!registry.valid(entity)) return false;
+    const ComponentRegistry::Ops* ops = ResolveComponent(componentName);
+    float xyz[3];
+    if (ops == nullptr || !ops->get(registry, entity, xyz)) return false;
+    FormatFloat3(xyz, out);
+    return true;
+}
+
+bool ECS::SetComponentValue(entt::entity entity, std::string_view componentName, std::string_view componentValue) {
+    if (!registry.valid(entity)) return false;
+
+    float xyz[3];
+    if (!ParseFloat3(componentValue, xyz)) {
+        Status::Log(Status::LogType::Error, "Error: Invalid value for {}", componentName);
+        return false;
+    }
+
+    const ComponentRegistry::Ops* ops = ResolveComponent(componentName);
+    return ops != nullptr && ops->set(registry, entity, xyz);
+}
+
+bool ECS::SaveScene(const std::string& path) {
+    return SceneSnapshot::Save(Registry(), &entityNames, path);
+}
+
+bool ECS::LoadScene(const std::string& path) {
+    MappedScene scene;
+    if (!scene.Open(path)) return false;
+    // Reject a bad file before anything is cleared, so the current scene stays
+    if (!SceneSnapshot::Validate(scene.Sections())) {
+        Status::SetError("Scene file is corrupt: " + path);
+        return false;
     }
 
+    // The snapshot loader restores identifiers as saved, so start from nothing
+    Registry().clear();
+    entityNames.Clear();
+    if (!scene.Instantiate(Registry(), &entityNames)) {
+        Status::SetError("Scene file is corrupt: " + path);
+        return false;
+    }
+    Status::SetSuccess("Scene loaded: " + path);
+    return true;
+}
 
-    
+bool ECS::StreamScene(SceneStreamer& streamer, const std::string& path) {
+    return streamer.Begin(Registry(), &entityNames, path);
 }
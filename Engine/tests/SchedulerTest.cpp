@@ -0,0 +1,149 @@
+// Scheduler staging and ParallelEach coverage with synthetic systems over the
+// scene components, plus the JobSystem waiting rule the Scheduler relies on.
+// Run through CTest, or directly: ./SchedulerTest
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include "entt.hpp"
+#include "ecs.hpp"
+#include "JobSystem.hpp"
+#include "Scheduler.hpp"
+
+static int failures = 0;
+
+#define CHECK(...)                                                                  \
+    do {                                                                            \
+        if (!(__VA_ARGS__)) {                                                       \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #__VA_ARGS__); \
+            failures++;                                                             \
+        }                                                                           \
+    } while (0)
+
+static void Populate(entt::registry& registry, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        const entt::entity entity = registry.create();
+        registry.emplace<Position>(entity, static_cast<float>(i), 0.0f, 0.0f);
+        registry.emplace<Rotation>(entity);
+        // Every other entity is scaled, so views over Scale skip some
+        if (i % 2 == 0) registry.emplace<Scale>(entity);
+    }
+}
+
+// A writer and a reader of the same component run in separate stages, in
+// registration order, so the reader sees every write
+static void ConflictingSystemsAreStaged(JobSystem& jobs) {
+    entt::registry registry;
+    Populate(registry, 10000);
+
+    std::atomic<std::size_t> stale{0};
+    Scheduler scheduler(registry, jobs);
+    scheduler.AddSystem<Reads<>, Writes<Position>>("Move", [](SystemContext& context) {
+        context.ParallelEach<Position>([](entt::entity, Position& position) { position.y = 1.0f; });
+    });
+    scheduler.AddSystem<Reads<Position>>("Observe", [&stale](SystemContext& context) {
+        context.ParallelEach<const Position>([&stale](entt::entity, const Position& position) {
+            if (position.y != 1.0f) stale.fetch_add(1, std::memory_order_relaxed);
+        });
+    });
+    // Two writers of one component conflict as well
+    scheduler.AddSystem<Reads<>, Writes<Position>>("Reset", [](SystemContext& context) {
+        context.ParallelEach<Position>([](entt::entity, Position& position) { position.z = 2.0f; });
+    });
+
+    CHECK(scheduler.StageCount() == 3);
+    scheduler.Run();
+    CHECK(stale.load() == 0);
+}
+
+// Systems over disjoint components, and readers of a shared one, share a stage
+static void IndependentSystemsShareAStage(JobSystem& jobs) {
+    entt::registry registry;
+    Populate(registry, 1000);
+
+    std::atomic<int> ran{0};
+    Scheduler scheduler(registry, jobs);
+    scheduler.AddSystem<Reads<>, Writes<Position>>("Position", [&ran](SystemContext&) { ran++; });
+    scheduler.AddSystem<Reads<>, Writes<Rotation>>("Rotation", [&ran](SystemContext&) { ran++; });
+    scheduler.AddSystem<Reads<Scale>>("ScaleA", [&ran](SystemContext&) { ran++; });
+    scheduler.AddSystem<Reads<Scale>>("ScaleB", [&ran](SystemContext&) { ran++; });
+
+    CHECK(scheduler.StageCount() == 1);
+    scheduler.Run();
+    CHECK(ran.load() == 4);
+
+    // A late writer of Scale conflicts with both readers
+    scheduler.AddSystem<Reads<>, Writes<Scale>>("ScaleWriter", [&ran](SystemContext&) { ran++; });
+    CHECK(scheduler.StageCount() == 2);
+}
+
+// Every entity of the view is visited exactly once, whatever the chunking
+static void ParallelEachVisitsEachEntityOnce(JobSystem& jobs) {
+    entt::registry registry;
+    const std::size_t count = 100000;
+    Populate(registry, count);
+
+    const std::size_t capacity = registry.storage<entt::entity>().size();
+    std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[capacity]);
+    for (std::size_t i = 0; i < capacity; i++) visits[i].store(0);
+
+    for (const std::size_t grain : {std::size_t{1}, std::size_t{64}, std::size_t{1024}, count * 2}) {
+        for (std::size_t i = 0; i < capacity; i++) visits[i].store(0);
+        std::atomic<std::size_t> visited{0};
+        Scheduler scheduler(registry, jobs);
+        scheduler.AddSystem<Reads<Position, Scale>>("Visit", [&](SystemContext& context) {
+            context.ParallelEach<const Position, const Scale>([&](entt::entity entity, const Position&, const Scale&) {
+                visits[entt::to_entity(entity)].fetch_add(1, std::memory_order_relaxed);
+            }, grain);
+            visited = context.Visited();
+        });
+        scheduler.Run();
+
+        std::size_t once = 0;
+        std::size_t wrong = 0;
+        for (auto [entity] : registry.storage<entt::entity>().each()) {
+            const int expected = registry.all_of<Scale>(entity) ? 1 : 0;
+            const int actual = visits[entt::to_entity(entity)].load();
+            if (actual != expected) wrong++;
+            if (actual == 1) once++;
+        }
+        CHECK(wrong == 0);
+        CHECK(once == count / 2);
+        CHECK(visited.load() == count / 2);
+    }
+}
+
+// Wait only runs jobs of the counter it waits on
+static void WaitLeavesOtherJobsQueued() {
+    // No workers: only waiting threads run jobs, which makes this deterministic
+    JobSystem jobs(0);
+    JobSystem::Counter other;
+    JobSystem::Counter mine;
+    bool otherRan = false;
+    bool mineRan = false;
+    jobs.Submit(other, [&otherRan] { otherRan = true; });
+    jobs.Submit(mine, [&mineRan] { mineRan = true; });
+
+    jobs.Wait(mine);
+    CHECK(mineRan);
+    CHECK(!otherRan);
+    CHECK(!other.Done());
+
+    jobs.Wait(other);
+    CHECK(otherRan);
+}
+
+int main() {
+    JobSystem jobs(3);
+    ConflictingSystemsAreStaged(jobs);
+    IndependentSystemsShareAStage(jobs);
+    ParallelEachVisitsEachEntityOnce(jobs);
+    WaitLeavesOtherJobsQueued();
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("SchedulerTest passed\n");
+    return 0;
+}
@@ -0,0 +1,119 @@
+// StateRing handoff between one writer and one reader: the pinned pair is
+// always two consecutive, fully written values, however the threads interleave.
+// Run through CTest, or directly: ./StateRingTest
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "StateRing.hpp"
+
+static int failures = 0;
+
+#define CHECK(...)                                                                  \
+    do {                                                                            \
+        if (!(__VA_ARGS__)) {                                                       \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #__VA_ARGS__); \
+            failures++;                                                             \
+        }                                                                           \
+    } while (0)
+
+// Every element holds the value's sequence number, so a torn value shows up
+struct Value {
+    std::uint64_t sequence = 0;
+    std::vector<std::uint64_t> payload;
+};
+
+static void Write(StateRing<Value>& ring, std::uint64_t sequence) {
+    Value& value = ring.Back();
+    value.sequence = sequence;
+    value.payload.assign(256, sequence);
+    ring.Publish();
+}
+
+static bool Intact(const Value& value) {
+    for (const std::uint64_t element : value.payload) {
+        if (element != value.sequence) return false;
+    }
+    return true;
+}
+
+// Nothing before the first publish, then the newest two
+static void PinsTheNewestPair() {
+    StateRing<Value> ring;
+    ring.Acquire();
+    CHECK(ring.Latest() == nullptr);
+    CHECK(ring.Previous() == nullptr);
+
+    Write(ring, 1);
+    ring.Acquire();
+    CHECK(ring.Latest() != nullptr && ring.Latest()->sequence == 1);
+    CHECK(ring.Previous() == nullptr);
+
+    Write(ring, 2);
+    Write(ring, 3);
+    ring.Acquire();
+    CHECK(ring.Latest() != nullptr && ring.Latest()->sequence == 3);
+    CHECK(ring.Previous() != nullptr && ring.Previous()->sequence == 2);
+}
+
+// A reader that falls behind keeps its pair intact; the writer never blocks
+static void PinnedPairSurvivesWrites() {
+    StateRing<Value> ring;
+    Write(ring, 1);
+    Write(ring, 2);
+    ring.Acquire();
+    for (std::uint64_t sequence = 3; sequence < 20; sequence++) Write(ring, sequence);
+
+    CHECK(ring.Latest() != nullptr && ring.Latest()->sequence == 2 && Intact(*ring.Latest()));
+    CHECK(ring.Previous() != nullptr && ring.Previous()->sequence == 1 && Intact(*ring.Previous()));
+
+    ring.Acquire();
+    CHECK(ring.Latest() != nullptr && ring.Latest()->sequence == 19);
+    // The previous may have been withdrawn to make room, but is never stale
+    CHECK(ring.Previous() == nullptr || ring.Previous()->sequence == 18);
+}
+
+static void ConcurrentHandoff() {
+    StateRing<Value> ring;
+    const std::uint64_t count = 200000;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (std::uint64_t sequence = 1; sequence <= count; sequence++) Write(ring, sequence);
+        done.store(true, std::memory_order_release);
+    });
+
+    std::uint64_t last = 0;
+    std::size_t torn = 0;
+    std::size_t unordered = 0;
+    while (!done.load(std::memory_order_acquire) || last < count) {
+        ring.Acquire();
+        const Value* latest = ring.Latest();
+        if (latest == nullptr) continue;
+        if (!Intact(*latest)) torn++;
+        if (latest->sequence < last) unordered++;
+        last = latest->sequence;
+        if (const Value* previous = ring.Previous()) {
+            if (!Intact(*previous)) torn++;
+            if (previous->sequence + 1 != latest->sequence) unordered++;
+        }
+    }
+    writer.join();
+    CHECK(torn == 0);
+    CHECK(unordered == 0);
+    CHECK(last == count);
+}
+
+int main() {
+    PinsTheNewestPair();
+    PinnedPairSurvivesWrites();
+    ConcurrentHandoff();
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("StateRingTest passed\n");
+    return 0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "entt.hpp"
+
+// Frame-stamped change log for selected component types.
+// Emplace/replace/patch on a tracked type stamp the entity with the current
+// frame, so consumers can ask for "entities whose Position changed since
+// frame N" and do work proportional to the number of edits.
+//
+// Only registry signals are observed: code that writes through get<>() must
+// call Touch() (on the thread that owns the registry) to be seen.
+//
+// Every edit appends an entry and nothing is dropped by itself: whoever owns
+// the tracker must call Trim() with the last frame all its consumers have
+// read, once per frame, or the log grows for as long as the world runs.
+class ChangeTracker {
+public:
+    explicit ChangeTracker(entt::registry& registry);
+
+    ChangeTracker(const ChangeTracker&) = delete;
+    ChangeTracker& operator=(const ChangeTracker&) = delete;
+
+    template<typename Component>
+    void Track() {
+        if (FindLog(entt::type_id<Component>().hash()) != nullptr) return;
+        logs.emplace_back(entt::type_id<Component>().hash(), std::make_unique<ComponentLog>());
+        connections.emplace_back(registry.on_construct<Component>().template connect<&ChangeTracker::OnChange<Component>>(*this));
+        connections.emplace_back(registry.on_update<Component>().template connect<&ChangeTracker::OnChange<Component>>(*this));
+        connections.emplace_back(registry.on_destroy<Component>().template connect<&ChangeTracker::OnRemove<Component>>(*this));
+    }
+
+    template<typename Component>
+    void Touch(entt::entity entity) {
+        if (ComponentLog* log = FindLog(entt::type_id<Component>().hash())) Stamp(*log, entity);
+    }
+
+    // Appends every entity whose Component changed after frame `since` and
+    // still has it. Each entity is reported once, however often it changed.
+    template<typename Component>
+    void ChangedSince(std::uint64_t since, std::vector<entt::entity>& out) const {
+        const ComponentLog* log = FindLog(entt::type_id<Component>().hash());
+        if (log != nullptr) Collect(*log, since, out);
+    }
+
+    // Frames start at 1; 0 means "before anything was tracked"
+    std::uint64_t Frame() const { return frame; }
+    void NextFrame() { frame++; }
+
+    // Forgets changes made in frames up to and including `upTo`; call it
+    // every frame with the oldest frame any consumer still reads from, minus one
+    void Trim(std::uint64_t upTo);
+
+private:
+    struct Entry {
+        std::uint64_t frame;
+        entt::entity entity;
+    };
+
+    struct ComponentLog {
+        std::vector<Entry> entries;             // ascending by frame
+        std::vector<std::uint64_t> lastFrame;   // by entity index, 0 = no live entry
+        std::vector<entt::entity> lastEntity;   // by entity index, guards against recycled ids
+    };
+
+    template<typename Component>
+    void OnChange(entt::registry&, entt::entity entity) { Stamp(LogFor<Component>(), entity); }
+
+    template<typename Component>
+    void OnRemove(entt::registry&, entt::entity entity) { Forget(LogFor<Component>(), entity); }
+
+    template<typename Component>
+    ComponentLog& LogFor() { return *FindLog(entt::type_id<Component>().hash()); }
+
+    ComponentLog* FindLog(entt::id_type type) const;
+    void Stamp(ComponentLog& log, entt::entity entity);
+    void Forget(ComponentLog& log, entt::entity entity);
+    void Collect(const ComponentLog& log, std::uint64_t since, std::vector<entt::entity>& out) const;
+
+    entt::registry& registry;
+    std::uint64_t frame = 1;
+    std::vector<std::pair<entt::id_type, std::unique_ptr<ComponentLog>>> logs;
+    std::vector<entt::scoped_connection> connections;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include "entt.hpp"
+#include "ecs.hpp"
+
+// Name-addressed access to the SceneComponents types.
+//
+// A table of typed function pointers is generated from the type list at
+// compile time, in list order, so a ComponentId is an index into it. Names
+// resolve to ids by hash; resolve once with Find() and keep the id, after
+// which every call is one table index and an indirect call.
+namespace ComponentRegistry {
+
+    struct Ops {
+        const char* name;
+        entt::id_type nameHash;
+        void (*add)(entt::registry&, entt::entity);
+        void (*remove)(entt::registry&, entt::entity);
+        bool (*has)(const entt::registry&, entt::entity);
+        // Every scene component is three floats (x, y, z); false if the entity lacks it
+        bool (*get)(const entt::registry&, entt::entity, float out[3]);
+        bool (*set)(entt::registry&, entt::entity, const float value[3]);
+    };
+
+    template<typename Component>
+    constexpr Ops MakeOps() {
+        return {
+            componentName<Component>,
+            entt::hashed_string::value(componentName<Component>, std::char_traits<char>::length(componentName<Component>)),
+            [](entt::registry& registry, entt::entity entity) { registry.emplace_or_replace<Component>(entity); },
+            [](entt::registry& registry, entt::entity entity) { registry.remove<Component>(entity); },
+            [](const entt::registry& registry, entt::entity entity) { return registry.all_of<Component>(entity); },
+            [](const entt::registry& registry, entt::entity entity, float out[3]) {
+                const Component* component = registry.try_get<Component>(entity);
+                if (component == nullptr) return false;
+                out[0] = component->x;
+                out[1] = component->y;
+                out[2] = component->z;
+                return true;
+            },
+            [](entt::registry& registry, entt::entity entity, const float value[3]) {
+                if (!registry.all_of<Component>(entity)) return false;
+                registry.replace<Component>(entity, value[0], value[1], value[2]);
+                return true;
+            },
+        };
+    }
+
+    template<typename... Component>
+    constexpr std::array<Ops, sizeof...(Component)> MakeTable(entt::type_list<Component...>) {
+        return {MakeOps<Component>()...};
+    }
+
+    inline constexpr std::array<Ops, SceneComponents::size> table = MakeTable(SceneComponents{});
+
+    template<typename Component>
+    constexpr ComponentId IdOf() {
+        return static_cast<ComponentId>(entt::type_list_index_v<Component, SceneComponents>);
+    }
+
+    // invalidComponent if no component has this name
+    ComponentId Find(std::string_view name);
+
+    inline const Ops* At(ComponentId id) {
+        return id < table.size() ? &table[id] : nullptr;
+    }
+
+    constexpr std::size_t Count() { return table.size(); }
+}
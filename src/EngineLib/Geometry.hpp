@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include "ecs.hpp"
+
+// Shared bounds and query shapes for the spatial indices.
+
+struct Aabb {
+    float min[3];
+    float max[3];
+};
+
+inline Aabb Union(const Aabb& a, const Aabb& b) {
+    return {{std::min(a.min[0], b.min[0]), std::min(a.min[1], b.min[1]), std::min(a.min[2], b.min[2])},
+            {std::max(a.max[0], b.max[0]), std::max(a.max[1], b.max[1]), std::max(a.max[2], b.max[2])}};
+}
+
+inline bool Overlaps(const Aabb& a, const Aabb& b) {
+    return a.min[0] <= b.max[0] && b.min[0] <= a.max[0] &&
+           a.min[1] <= b.max[1] && b.min[1] <= a.max[1] &&
+           a.min[2] <= b.max[2] && b.min[2] <= a.max[2];
+}
+
+inline bool Contains(const Aabb& outer, const Aabb& inner) {
+    return outer.min[0] <= inner.min[0] && outer.min[1] <= inner.min[1] && outer.min[2] <= inner.min[2] &&
+           inner.max[0] <= outer.max[0] && inner.max[1] <= outer.max[1] && inner.max[2] <= outer.max[2];
+}
+
+// Half the surface area; only ever compared, so the factor of two is dropped
+inline float SurfaceArea(const Aabb& box) {
+    const float dx = box.max[0] - box.min[0];
+    const float dy = box.max[1] - box.min[1];
+    const float dz = box.max[2] - box.min[2];
+    return dx * dy + dy * dz + dz * dx;
+}
+
+inline bool OverlapsSphere(const Aabb& box, const float center[3], float radius) {
+    float distance = 0.0f;
+    for (int axis = 0; axis < 3; axis++) {
+        const float d = std::max({box.min[axis] - center[axis], 0.0f, center[axis] - box.max[axis]});
+        distance += d * d;
+    }
+    return distance <= radius * radius;
+}
+
+struct Ray {
+    float origin[3];
+    float direction[3];
+    float maxDistance;
+};
+
+// Slab test; inverseDirection is 1/direction per axis (infinities are fine)
+inline bool IntersectRay(const Aabb& box, const float origin[3], const float inverseDirection[3],
+                         float maxDistance, float& entry) {
+    float tNear = 0.0f;
+    float tFar = maxDistance;
+    for (int axis = 0; axis < 3; axis++) {
+        float t0 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+        float t1 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        // NaN (origin on a slab plane of a flat axis) keeps the current bound
+        tNear = t0 > tNear ? t0 : tNear;
+        tFar = t1 < tFar ? t1 : tFar;
+        if (tNear > tFar) return false;
+    }
+    entry = tNear;
+    return true;
+}
+
+// Six inward-facing planes (a, b, c, d) with a*x + b*y + c*z + d >= 0 inside
+struct Frustum {
+    float planes[6][4];
+
+    // Extracts the planes of a column-major view-projection matrix (OpenGL clip space)
+    static Frustum FromMatrix(const float m[16]);
+
+    // Conservative: may accept boxes just outside a corner, never rejects a visible one
+    bool Overlaps(const Aabb& box) const {
+        for (const auto& plane : planes) {
+            const float x = plane[0] >= 0.0f ? box.max[0] : box.min[0];
+            const float y = plane[1] >= 0.0f ? box.max[1] : box.min[1];
+            const float z = plane[2] >= 0.0f ? box.max[2] : box.min[2];
+            if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0f) return false;
+        }
+        return true;
+    }
+
+    // True when the whole box is inside, so a subtree can be accepted without further tests
+    bool Contains(const Aabb& box) const {
+        for (const auto& plane : planes) {
+            const float x = plane[0] >= 0.0f ? box.min[0] : box.max[0];
+            const float y = plane[1] >= 0.0f ? box.min[1] : box.max[1];
+            const float z = plane[2] >= 0.0f ? box.min[2] : box.max[2];
+            if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0f) return false;
+        }
+        return true;
+    }
+};
+
+// World bounds of the unit cube an entity is drawn as; rotation is optional
+Aabb EntityBounds(const Position& position, const Rotation* rotation, const Scale& scale);
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of worker threads fed from one shared queue.
+// Waiting threads help with the queued jobs of the counter they wait on, so
+// jobs may submit and wait on nested jobs (e.g. a system splitting its view)
+// without deadlocking. They never pick up someone else's job, so a frame
+// waiting on its systems is not stalled by a long job from another user of
+// the pool (scene streaming).
+class JobSystem {
+public:
+    // Tracks a batch of submitted jobs
+    class Counter {
+    public:
+        bool Done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+        std::atomic<std::size_t> pending{0};
+    };
+
+    explicit JobSystem(std::size_t workerCount = DefaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void Submit(Counter& counter, std::function<void()> job);
+    void Wait(Counter& counter);
+
+    // Splits [0, count) into chunks of at least grain items and runs
+    // fn(begin, end) for each of them across the pool and the calling thread.
+    void ParallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& fn);
+
+    // Worker threads plus the thread that waits
+    std::size_t ThreadCount() const { return workers.size() + 1; }
+
+    // 0 for threads outside the pool, 1..N for pool workers
+    static std::size_t CurrentWorker();
+    static std::size_t DefaultWorkerCount();
+
+private:
+    struct Job {
+        std::function<void()> fn;
+        Counter* counter;
+    };
+
+    // Runs one queued job of counter on the calling thread, if there is one
+    bool TryRunOne(const Counter& counter);
+    void WorkerLoop(std::size_t index);
+
+    std::vector<std::thread> workers;
+    std::deque<Job> queue;
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    bool stopping = false;
+};
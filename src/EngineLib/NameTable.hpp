@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "entt.hpp"
+
+// Interned entity names.
+// Names live back to back in a single arena and are indexed by an
+// open-addressing hash table, so Find() never allocates and costs one hash
+// plus (usually) one probe.
+class NameTable {
+public:
+    // Returns false if the name is empty, already taken, or the entity already has a name.
+    // A name left behind by an older version of the entity's index is dropped.
+    bool Insert(std::string_view name, entt::entity entity);
+    // Returns entt::null when no entity carries the name
+    entt::entity Find(std::string_view name) const;
+    // Returns an empty view for unnamed entities; valid until the next Insert/Erase
+    std::string_view NameOf(entt::entity entity) const;
+    void Erase(entt::entity entity);
+    void Clear();
+
+    std::size_t Size() const { return count; }
+
+    // Calls fn(entity, name) for every named entity
+    template<typename Fn>
+    void Each(Fn&& fn) const {
+        for (const Slot& slot : slots) {
+            if (slot.state == SlotState::Live) fn(slot.entity, std::string_view(arena.data() + slot.offset, slot.length));
+        }
+    }
+
+private:
+    enum class SlotState : std::uint8_t { Empty, Live, Erased };
+
+    struct Slot {
+        std::uint32_t hash = 0;
+        std::uint32_t offset = 0;
+        std::uint32_t length = 0;
+        entt::entity entity = entt::null;
+        SlotState state = SlotState::Empty;
+    };
+
+    std::size_t FindSlot(std::string_view name, std::uint32_t hash) const;
+    void EraseSlot(std::size_t i);
+    void Rehash(std::size_t capacity);
+    void CompactArena();
+
+    std::vector<Slot> slots;
+    std::vector<char> arena;
+    std::vector<std::uint32_t> slotOfEntity; // entity index -> slot + 1, 0 if unnamed
+    std::size_t count = 0;
+    std::size_t tombstones = 0;
+    std::size_t deadBytes = 0;
+};
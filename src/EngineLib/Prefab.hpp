@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "entt.hpp"
+
+// Entity layout stored once: a component set with default values.
+// Instantiate() reserves every storage up front, then makes the N copies in
+// blocks of 4096 entities: a range create and one bulk insert per component
+// storage for each block, instead of N separate create + emplace calls.
+// Blocks keep the entity ids and the storage pages just written in cache
+// while the next storage is filled, which a single pass over N would not.
+class Prefab {
+public:
+    // Adds Component with the given default value, or replaces the default
+    template<typename Component, typename... Args>
+    Prefab& With(Args&&... args) {
+        Component value{std::forward<Args>(args)...};
+        if (Entry* entry = Find(entt::type_id<Component>().hash())) {
+            entry->value = std::move(value);
+        } else {
+            entries.push_back({entt::type_id<Component>().hash(), entt::any{std::move(value)}, &Reserve<Component>, &Fill<Component>});
+        }
+        return *this;
+    }
+
+    template<typename Component>
+    Prefab& Without() {
+        const entt::id_type type = entt::type_id<Component>().hash();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->type == type) {
+                entries.erase(it);
+                break;
+            }
+        }
+        return *this;
+    }
+
+    template<typename Component>
+    bool Has() const { return Find(entt::type_id<Component>().hash()) != nullptr; }
+
+    // Default value of Component, or nullptr if the prefab does not have it
+    template<typename Component>
+    const Component* Get() const {
+        const Entry* entry = Find(entt::type_id<Component>().hash());
+        return entry != nullptr ? entt::any_cast<Component>(&entry->value) : nullptr;
+    }
+
+    std::size_t ComponentCount() const { return entries.size(); }
+
+    void Instantiate(entt::registry& registry, entt::entity* first, entt::entity* last) const;
+    std::vector<entt::entity> Instantiate(entt::registry& registry, std::size_t count) const;
+
+private:
+    static constexpr std::ptrdiff_t blockSize = 4096;
+
+    using ReserveFn = void (*)(entt::registry&, std::size_t);
+    using FillFn = void (*)(entt::registry&, const entt::entity*, const entt::entity*, const entt::any&);
+
+    struct Entry {
+        entt::id_type type;
+        entt::any value;
+        ReserveFn reserve;
+        FillFn fill;
+    };
+
+    template<typename Component>
+    static void Reserve(entt::registry& registry, std::size_t count) {
+        auto& storage = registry.storage<Component>();
+        storage.reserve(storage.size() + count);
+    }
+
+    template<typename Component>
+    static void Fill(entt::registry& registry, const entt::entity* first, const entt::entity* last, const entt::any& value) {
+        registry.storage<Component>().insert(first, last, entt::any_cast<const Component&>(value));
+    }
+
+    Entry* Find(entt::id_type type) {
+        for (Entry& entry : entries) {
+            if (entry.type == type) return &entry;
+        }
+        return nullptr;
+    }
+
+    const Entry* Find(entt::id_type type) const {
+        for (const Entry& entry : entries) {
+            if (entry.type == type) return &entry;
+        }
+        return nullptr;
+    }
+
+    std::vector<Entry> entries;
+};
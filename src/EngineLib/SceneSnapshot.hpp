@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "entt.hpp"
+#include "NameTable.hpp"
+#include "ecs.hpp"
+
+// Binary .OmniScene format.
+//
+//   FileHeader, then one section per storage. Each section is a
+//   SectionHeader followed by the entity array and the raw component array,
+//   both padded to 16 bytes, so a loader walks a handful of large contiguous
+//   blocks instead of parsing fields. The entity section comes first; the
+//   optional name section stores name lengths followed by the name bytes.
+//
+// Components must be trivially copyable; they are written in native layout.
+namespace SceneSnapshot {
+
+    constexpr char magic[8] = {'O', 'M', 'N', 'I', 'S', 'C', 'N', '\0'};
+    constexpr std::uint32_t version = 1;
+    constexpr std::size_t alignment = 16;
+
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t sectionCount;
+    };
+
+    struct SectionHeader {
+        std::uint32_t id;            // SectionId<Component>() or one of the ids below
+        std::uint32_t elementSize;   // bytes per component, 0 for entity/name sections
+        std::uint32_t count;         // entities in the section
+        std::uint32_t extra;         // free list size for the entity section
+        std::uint64_t payloadBytes;  // component or name bytes after the entity array
+        std::uint64_t reserved;
+    };
+
+    static_assert(sizeof(FileHeader) == alignment, "FileHeader must stay 16 bytes");
+    static_assert(sizeof(SectionHeader) % alignment == 0, "SectionHeader must keep arrays aligned");
+
+    constexpr std::uint32_t entitySectionId = entt::hashed_string::value("entt::entity");
+    constexpr std::uint32_t nameSectionId = entt::hashed_string::value("EntityNames");
+
+    // Sections are keyed by the component's stable name, not its C++ type id
+    template<typename Component>
+    constexpr std::uint32_t SectionId() {
+        return entt::hashed_string::value(componentName<Component>, std::char_traits<char>::length(componentName<Component>));
+    }
+
+    // One storage inside a buffer or mapping; the pointers alias the source bytes
+    struct Section {
+        SectionHeader header;
+        const unsigned char* entities;   // header.count entity ids
+        const unsigned char* payload;    // header.payloadBytes bytes, 16-byte aligned
+    };
+
+    // Validates the file and section headers without touching the arrays
+    bool ParseSections(const unsigned char* data, std::size_t size, std::vector<Section>& out);
+    // Runs every check Instantiate() can fail on, without a registry, so a
+    // caller can keep its current scene when the file would not load
+    bool Validate(const std::vector<Section>& sections);
+    // Builds storages from parsed sections into an empty registry
+    bool Instantiate(entt::registry& registry, NameTable* names, const std::vector<Section>& sections);
+
+    // Serializes every entity and every SceneComponents storage
+    void Write(const entt::registry& registry, const NameTable* names, std::vector<unsigned char>& out);
+    // Restores into an empty registry; returns false on a malformed buffer
+    bool Read(entt::registry& registry, NameTable* names, const unsigned char* data, std::size_t size);
+
+    bool Save(const entt::registry& registry, const NameTable* names, const std::string& path);
+    bool Load(entt::registry& registry, NameTable* names, const std::string& path);
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "entt.hpp"
+#include "Geometry.hpp"
+#include "JobSystem.hpp"
+
+// Uniform-grid spatial hash over every entity with a Position, for scenes
+// where most things move every frame (particles, crowds, projectiles).
+//
+// Nothing is maintained incrementally: Rebuild() hashes each position's cell
+// into a bucket, radix sorts by bucket and lays the entries out so every
+// bucket is one contiguous run. Buckets can hold several cells, so entries
+// carry their cell and queries skip the ones that do not match.
+class SpatialGrid {
+public:
+    struct Item {
+        float position[3];
+        std::int32_t cell[3];
+        entt::entity entity;
+    };
+
+    explicit SpatialGrid(entt::registry& registry, float cellSize = 1.0f);
+
+    SpatialGrid(const SpatialGrid&) = delete;
+    SpatialGrid& operator=(const SpatialGrid&) = delete;
+
+    // Re-reads every Position; parallel across jobs when given. Queries see
+    // the positions as of the last rebuild.
+    void Rebuild(JobSystem* jobs = nullptr);
+
+    // Takes effect on the next Rebuild(). Around the typical query radius works best.
+    void SetCellSize(float size) { cellSize = size; }
+    float CellSize() const { return cellSize; }
+
+    // Calls fn(const Item&) for each entity whose position lies in box
+    template<typename Fn>
+    void ForEachInBox(const Aabb& box, Fn&& fn) const {
+        std::int32_t low[3], high[3];
+        if (!CellRange(box, low, high)) return;
+        ForEachCell(low, high, [&](const Item& item, bool interior) {
+            if (interior || (item.position[0] >= box.min[0] && item.position[0] <= box.max[0] &&
+                             item.position[1] >= box.min[1] && item.position[1] <= box.max[1] &&
+                             item.position[2] >= box.min[2] && item.position[2] <= box.max[2])) {
+                fn(item);
+            }
+        });
+    }
+
+    // Calls fn(const Item&) for each entity within radius of center
+    template<typename Fn>
+    void ForEachNeighbour(const float center[3], float radius, Fn&& fn) const {
+        const Aabb box = {{center[0] - radius, center[1] - radius, center[2] - radius},
+                          {center[0] + radius, center[1] + radius, center[2] + radius}};
+        std::int32_t low[3], high[3];
+        if (!CellRange(box, low, high)) return;
+        const float radiusSquared = radius * radius;
+        ForEachCell(low, high, [&](const Item& item, bool) {
+            const float dx = item.position[0] - center[0];
+            const float dy = item.position[1] - center[1];
+            const float dz = item.position[2] - center[2];
+            if (dx * dx + dy * dy + dz * dz <= radiusSquared) fn(item);
+        });
+    }
+
+    void QueryBox(const Aabb& box, std::vector<entt::entity>& out) const;
+    void QueryRadius(const float center[3], float radius, std::vector<entt::entity>& out) const;
+    // Entities within radius of entity's current Position, excluding itself
+    void Neighbours(entt::entity entity, float radius, std::vector<entt::entity>& out) const;
+
+    // All entries, grouped by bucket
+    const std::vector<Item>& Items() const { return items; }
+    std::size_t Size() const { return items.size(); }
+
+private:
+    static std::uint32_t Hash(std::int32_t x, std::int32_t y, std::int32_t z) {
+        std::uint32_t h = static_cast<std::uint32_t>(x) * 73856093u ^
+                          static_cast<std::uint32_t>(y) * 19349663u ^
+                          static_cast<std::uint32_t>(z) * 83492791u;
+        h ^= h >> 16;
+        h *= 0x45d9f3bu;
+        return h ^ (h >> 16);
+    }
+
+    // Clamped so huge coordinates cannot overflow the conversion
+    static std::int32_t CellOf(float value, float inverseSize) {
+        const float cell = std::floor(value * inverseSize);
+        return static_cast<std::int32_t>(std::fmax(-1073741824.0f, std::fmin(cell, 1073741824.0f)));
+    }
+
+    bool CellRange(const Aabb& box, std::int32_t low[3], std::int32_t high[3]) const;
+
+    // Calls fn(item, interior) for the items of every cell in [low, high];
+    // interior cells lie strictly inside the range, so their items need no test
+    template<typename Fn>
+    void ForEachCell(const std::int32_t low[3], const std::int32_t high[3], Fn&& fn) const {
+        // Widened first: clamped cells still span up to 2^31 per axis, and the
+        // product of three spans can exceed 64 bits, so stop once it passes
+        // the item count
+        std::uint64_t span[3];
+        for (int axis = 0; axis < 3; axis++) {
+            const std::int64_t cellsOnAxis = static_cast<std::int64_t>(high[axis]) - static_cast<std::int64_t>(low[axis]) + 1;
+            if (cellsOnAxis <= 0) return;
+            span[axis] = static_cast<std::uint64_t>(cellsOnAxis);
+        }
+        const std::uint64_t area = span[0] * span[1];
+        // A range covering more cells than there are items is cheaper to scan
+        if (area > items.size() || area * span[2] > items.size()) {
+            for (const Item& item : items) fn(item, false);
+            return;
+        }
+
+        for (std::int32_t z = low[2]; z <= high[2]; z++) {
+            for (std::int32_t y = low[1]; y <= high[1]; y++) {
+                for (std::int32_t x = low[0]; x <= high[0]; x++) {
+                    const bool interior = x > low[0] && x < high[0] && y > low[1] && y < high[1] && z > low[2] && z < high[2];
+                    const std::uint32_t bucket = Hash(x, y, z) & bucketMask;
+                    const Item* item = items.data() + bucketStart[bucket];
+                    const Item* end = items.data() + bucketStart[bucket + 1];
+                    for (; item != end; ++item) {
+                        if (item->cell[0] == x && item->cell[1] == y && item->cell[2] == z) fn(*item, interior);
+                    }
+                }
+            }
+        }
+    }
+
+    entt::registry& registry;
+    float cellSize;
+    float builtCellSize = 1.0f;
+
+    std::vector<Item> items;
+    std::vector<std::uint32_t> bucketStart;  // bucketMask + 2 offsets into items
+    std::uint32_t bucketMask = 0;
+
+    // Rebuild scratch, kept to avoid reallocating every frame
+    std::vector<Item> scratch;
+    std::vector<std::uint32_t> keys;         // bucket of each item
+    std::vector<std::uint32_t> sortedKeys;
+    std::vector<std::uint32_t> histograms;   // per chunk, per digit
+};
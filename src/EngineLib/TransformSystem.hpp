@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "entt.hpp"
+#include "ChangeTracker.hpp"
+#include "ecs.hpp"
+
+// Column-major 4x4 matrix, laid out like the editor's Mat4 so it can be
+// handed straight to glUniformMatrix4fv.
+struct WorldMatrix {
+    float m[16];
+};
+
+// Model matrix kernels: world = T(position) * Ry * Rx * Rz * S(scale), with
+// Rotation holding Euler angles in degrees.
+namespace TransformKernels {
+
+    enum class Path { Scalar, SSE, AVX };
+
+    // Widest kernel compiled into this build (AVX needs -mavx, see ENGINE_ENABLE_AVX)
+    Path ActivePath();
+    const char* PathName(Path path);
+
+    void ComputeScalar(const Position* positions, const Rotation* rotations, const Scale* scales,
+                       std::size_t count, WorldMatrix* out);
+    void Compute(const Position* positions, const Rotation* rotations, const Scale* scales,
+                 std::size_t count, WorldMatrix* out);
+}
+
+// Rebuilds world matrices for every entity with Position, Rotation and Scale.
+// The three storages are owned by one entt group so they stay packed in the
+// same order, and the kernels stream over them page by page.
+class TransformSystem {
+public:
+    explicit TransformSystem(entt::registry& registry);
+
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+
+    // Rebuilds every matrix
+    void Update();
+
+    // Rewrites only the matrices of entities whose Position, Rotation or Scale
+    // changed after frame `since` (the tracker must Track<> all three). Falls
+    // back to a full rebuild when entities joined or left the group. Changes
+    // made later in the same frame are only seen if the next call passes a
+    // `since` before the current frame; the tracker's owner trims up to it.
+    void Update(const ChangeTracker& changes, std::uint64_t since);
+    // Forces the next Update() to rebuild everything, e.g. after
+    // RegistryMaintenance reordered the owned storages
+    void Invalidate() { structureChanged = true; }
+
+    // What the last update touched: everything, or UpdatedIndices() into Matrices()
+    bool FullRebuild() const { return fullRebuild; }
+    const std::vector<std::uint32_t>& UpdatedIndices() const { return updated; }
+
+    // Matrices()[i] belongs to Entities()[i]; both are valid until the next
+    // Update() or structural change to the owned storages.
+    const WorldMatrix* Matrices() const { return matrices.data(); }
+    const entt::entity* Entities() const { return entities; }
+    std::size_t Size() const { return matrices.size(); }
+
+private:
+    void OnStructureChange(entt::registry&, entt::entity) { structureChanged = true; }
+
+    entt::registry& registry;
+    std::vector<WorldMatrix> matrices;
+    const entt::entity* entities = nullptr;
+
+    bool structureChanged = true;
+    bool fullRebuild = false;
+    std::vector<std::uint32_t> updated;
+    std::vector<entt::entity> changed;
+    std::vector<Position> scratchPositions;
+    std::vector<Rotation> scratchRotations;
+    std::vector<Scale> scratchScales;
+    std::vector<WorldMatrix> scratchMatrices;
+    std::vector<entt::scoped_connection> connections;
+};
@@ -34,15 +34,15 @@ const char* Renderer::vertexShaderSource = R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
+layout (location = 2) in mat4 aModel;
 
-uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
 out vec3 vertexColor;
 
 void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    gl_Position = projection * view * aModel * vec4(aPos, 1.0);
     vertexColor = aColor;
 }
 )";
@@ -57,7 +57,11 @@ void main() {
 }
 )";
 
-Renderer::Renderer() : VAO(0), VBO(0), EBO(0) {
+static_assert(sizeof(WorldMatrix) == 16 * sizeof(float), "WorldMatrix must stay a tightly packed mat4");
+
+Renderer::Renderer()
+    : VAO(0), VBO(0), EBO(0), instanceVBO(0), instanceCapacity(0), viewLocation(-1), projectionLocation(-1),
+      uploadedSize{0.5f, 0.5f, 0.5f} {
 }
 
 Renderer::~Renderer() {
@@ -81,6 +85,7 @@ void Renderer::setupCube() {
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
     glGenBuffers(1, &EBO);
+    glGenBuffers(1, &instanceVBO);
     
     glBindVertexArray(VAO);
     
@@ -98,6 +103,14 @@ void Renderer::setupCube() {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
+    // Model matrix attribute, one per instance: a mat4 takes four vec4 locations
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    for (GLuint column = 0; column < 4; column++) {
+        glVertexAttribPointer(2 + column, 4, GL_FLOAT, GL_FALSE, sizeof(WorldMatrix), (void*)(column * 4 * sizeof(float)));
+        glEnableVertexAttribArray(2 + column);
+        glVertexAttribDivisor(2 + column, 1);
+    }
+    
     glBindVertexArray(0);
 }
 
@@ -105,9 +118,11 @@ void Renderer::createShaders() {
     if (!cubeShader.loadFromSource(vertexShaderSource, fragmentShaderSource)) {
         std::cerr << "Failed to create cube shader!" << std::endl;
     }
+    viewLocation = cubeShader.getUniformLocation("view");
+    projectionLocation = cubeShader.getUniformLocation("projection");
 }
 
-void Renderer::render(const Camera& camera, float aspectRatio, const UI* ui) {
+void Renderer::render(const Camera& camera, float aspectRatio, const UI* ui, const std::vector<WorldMatrix>* entities) {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
     
@@ -122,32 +137,52 @@ void Renderer::render(const Camera& camera, float aspectRatio, const UI* ui) {
         sy = ui->getSizeY();
         sz = ui->getSizeZ();
     }
-    // Update positions (every 6 floats: x,y,z,r,g,b)
-    float scaled[] = {
-        -sx, -sy, -sz,  1.0f, 0.0f, 0.0f,
-         sx, -sy, -sz,  0.0f, 1.0f, 0.0f,
-         sx,  sy, -sz,  0.0f, 0.0f, 1.0f,
-        -sx,  sy, -sz,  1.0f, 1.0f, 0.0f,
-        -sx, -sy,  sz,  1.0f, 0.0f, 1.0f,
-         sx, -sy,  sz,  0.0f, 1.0f, 1.0f,
-         sx,  sy,  sz,  1.0f, 1.0f, 1.0f,
-        -sx,  sy,  sz,  0.5f, 0.5f, 0.5f
-    };
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(scaled), scaled);
+    // Only touch the VBO when the size actually changed
+    if (sx != uploadedSize[0] || sy != uploadedSize[1] || sz != uploadedSize[2]) {
+        // Update positions (every 6 floats: x,y,z,r,g,b)
+        float scaled[] = {
+            -sx, -sy, -sz,  1.0f, 0.0f, 0.0f,
+             sx, -sy, -sz,  0.0f, 1.0f, 0.0f,
+             sx,  sy, -sz,  0.0f, 0.0f, 1.0f,
+            -sx,  sy, -sz,  1.0f, 1.0f, 0.0f,
+            -sx, -sy,  sz,  1.0f, 0.0f, 1.0f,
+             sx, -sy,  sz,  0.0f, 1.0f, 1.0f,
+             sx,  sy,  sz,  1.0f, 1.0f, 1.0f,
+            -sx,  sy,  sz,  0.5f, 0.5f, 0.5f
+        };
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(scaled), scaled);
+        uploadedSize[0] = sx;
+        uploadedSize[1] = sy;
+        uploadedSize[2] = sz;
+    }
 
     // Set transformation matrices
-    Mat4 model; // Identity matrix (cube at origin)
     Mat4 view = camera.getViewMatrix();
     Mat4 projection = camera.getProjectionMatrix(aspectRatio);
     
-    cubeShader.setMat4("model", model);
-    cubeShader.setMat4("view", view);
-    cubeShader.setMat4("projection", projection);
+    cubeShader.setMat4(viewLocation, view);
+    cubeShader.setMat4(projectionLocation, projection);
     
-    // Render cube
+    // Instance 0 is the editor cube at the origin; scene entities share the cube
+    // mesh. WorldMatrix has Mat4's column-major layout, so it uploads as is.
+    const std::size_t entityCount = entities != nullptr ? entities->size() : 0;
+    const std::size_t instances = 1 + entityCount;
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (instances > instanceCapacity) {
+        instanceCapacity = instances + instances / 2;
+    }
+    // Orphan the previous frame's storage so the upload never waits on the GPU
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(WorldMatrix), nullptr, GL_STREAM_DRAW);
+    const Mat4 model; // Identity matrix (cube at origin)
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(WorldMatrix), model.m);
+    if (entityCount > 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, sizeof(WorldMatrix), entityCount * sizeof(WorldMatrix), entities->data());
+    }
+    
+    // Render every cube in one call
     glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+    glDrawElementsInstanced(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0, static_cast<GLsizei>(instances));
     glBindVertexArray(0);
 }
 
@@ -164,4 +199,9 @@ void Renderer::cleanup() {
         glDeleteBuffers(1, &EBO);
         EBO = 0;
     }
+    if (instanceVBO != 0) {
+        glDeleteBuffers(1, &instanceVBO);
+        instanceVBO = 0;
+        instanceCapacity = 0;
+    }
 }
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <OpenGL/gl3.h>
+#include <vector>
 #include "Shader.h"
 #include "Camera.h"
 #include "UI.h"
+#include "EngineLib/TransformSystem.hpp"
 
 class Renderer {
 public:
@@ -11,7 +13,10 @@ public:
     ~Renderer();
     
     bool initialize();
-    void render(const Camera& camera, float aspectRatio, const UI* ui = nullptr);
+    // entities: one cube per world matrix (interpolated simulation state), drawn
+    // with the editor cube in a single instanced call
+    void render(const Camera& camera, float aspectRatio, const UI* ui = nullptr,
+                const std::vector<WorldMatrix>* entities = nullptr);
     void cleanup();
     
 private:
@@ -19,7 +24,15 @@ private:
     void createShaders();
     
     GLuint VAO, VBO, EBO;
+    // Per-instance model matrices: the editor cube's identity, then the entities
+    GLuint instanceVBO;
+    std::size_t instanceCapacity;
     Shader cubeShader;
+    GLint viewLocation;
+    GLint projectionLocation;
+    
+    // Cube half-extents currently in VBO; the buffer is only rewritten when the UI changes them
+    float uploadedSize[3];
     
     static float cubeVertices[];
     static const unsigned int cubeIndices[];
@@ -34,7 +34,10 @@ void Shader::use() {
 }
 
 void Shader::setMat4(const std::string& name, const Mat4& matrix) {
-    GLint location = getUniformLocation(name);
+    setMat4(getUniformLocation(name), matrix);
+}
+
+void Shader::setMat4(GLint location, const Mat4& matrix) {
     if (location != -1) {
         glUniformMatrix4fv(location, 1, GL_FALSE, matrix.m);
     }
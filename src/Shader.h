@@ -13,16 +13,18 @@ public:
     void use();
     
     void setMat4(const std::string& name, const Mat4& matrix);
+    // Per-frame uniforms: look the location up once with getUniformLocation()
+    void setMat4(GLint location, const Mat4& matrix);
     void setVec3(const std::string& name, const Vec3& vector);
     void setFloat(const std::string& name, float value);
     void setInt(const std::string& name, int value);
     
     GLuint getProgram() const { return program; }
+    GLint getUniformLocation(const std::string& name);
     
 private:
     GLuint program;
     
     GLuint compileShader(const std::string& source, GLenum type);
     bool linkProgram(GLuint vertexShader, GLuint fragmentShader);
-    GLint getUniformLocation(const std::string& name);
 };
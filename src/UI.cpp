@@ -4,15 +4,19 @@
 #include "Panels.h"
 #include "EngineLib/File.hpp"
 #include "EngineLib/Status.hpp"
+#include "EngineLib/SystemProfiler.hpp"
+#include "EngineLib/ecs.hpp"
 #include <OpenGL/gl3.h>
 #include <CoreFoundation/CoreFoundation.h>
 #include <CoreGraphics/CoreGraphics.h>
+#include <cstdint>
 #include <cstdio>
 #include <vector>
 #include <algorithm>
 #include <fstream>
 #include <filesystem>
 #include <cstdlib>
+#include <ctime>
 
 namespace {
     // Utility: render text centered within a rectangle
@@ -100,6 +104,89 @@ namespace {
         return s;
     }
 
+    // Output panel rows for the current filter. A row counts as one line
+    // until it first scrolls into view; only then is its entry formatted and
+    // its wrapped height measured (again only when the panel width changes),
+    // so entries nobody looks at are never formatted.
+    struct LogViewState {
+        int filter = -1;                      // -1 shows every type, otherwise a Status::LogType
+        float width = -1.0f;                  // content width the line counts were measured at
+        std::uint64_t next = 0;               // first history sequence not looked at yet
+        std::vector<std::uint64_t> rows;      // history sequences shown, oldest first
+        std::vector<std::uint64_t> lineStart; // first line of each row, plus the line after the last
+        std::vector<bool> measured;           // false while a row has its provisional one-line height
+        std::size_t front = 0;                // rows before this were evicted from the history
+    };
+
+    LogViewState& logViewState() {
+        static LogViewState s;
+        return s;
+    }
+
+    // Brings the view up to date with the history; new rows start unmeasured
+    void updateLogView(LogViewState& view, const Status::LogHistory& logs, float width, int filter) {
+        if (width != view.width || filter != view.filter) {
+            view.width = width;
+            view.filter = filter;
+            view.next = logs.FirstSequence();
+            view.rows.clear();
+            view.lineStart.assign(1, 0);
+            view.measured.clear();
+            view.front = 0;
+        }
+        // Evicted or cleared since the last frame
+        while (view.front < view.rows.size() && view.rows[view.front] < logs.FirstSequence()) view.front++;
+        if (view.front >= 4096 && view.front * 2 >= view.rows.size()) {
+            view.rows.erase(view.rows.begin(), view.rows.begin() + view.front);
+            view.lineStart.erase(view.lineStart.begin(), view.lineStart.begin() + view.front);
+            view.measured.erase(view.measured.begin(), view.measured.begin() + view.front);
+            view.front = 0;
+        }
+
+        auto add = [&view](std::uint64_t sequence) {
+            view.rows.push_back(sequence);
+            view.lineStart.push_back(view.lineStart.back() + 1);
+            view.measured.push_back(false);
+        };
+        // Only entries that arrived since the last frame; a filtered view
+        // finds them through the history's per-type index
+        const std::uint64_t from = std::max(view.next, logs.FirstSequence());
+        if (filter < 0) {
+            for (std::uint64_t sequence = from; sequence < logs.EndSequence(); sequence++) add(sequence);
+        } else {
+            const auto type = static_cast<Status::LogType>(filter);
+            for (std::size_t i = logs.FindOf(type, from); i < logs.CountOf(type); i++) add(logs.SequenceOf(type, i));
+        }
+        view.next = logs.EndSequence();
+    }
+
+    // Formats and measures the rows covering lines [firstLine, lastLine) that
+    // still have their provisional height, and moves the rows below them down;
+    // wrapWidth[type] is the width left for a message after its type prefix
+    void measureLogView(LogViewState& view, const Status::LogHistory& logs, const float* wrapWidth,
+                        std::uint64_t firstLine, std::uint64_t lastLine) {
+        if (view.front >= view.rows.size()) return;
+        const float lineHeight = ImGui::GetTextLineHeight();
+        std::string scratch;
+        std::uint64_t shift = 0;
+        std::size_t row = std::upper_bound(view.lineStart.begin() + view.front, view.lineStart.end() - 1, firstLine) -
+                          view.lineStart.begin() - 1;
+        for (; row < view.rows.size(); row++) {
+            view.lineStart[row] += shift;
+            if (view.lineStart[row] >= lastLine) break;
+            if (view.measured[row]) continue;
+            view.measured[row] = true;
+            const Status::LogEntry entry = logs.At(view.rows[row]);
+            const std::string_view text = entry.Text(scratch);
+            const float height =
+                ImGui::CalcTextSize(text.data(), text.data() + text.size(), false, wrapWidth[static_cast<int>(entry.type)]).y;
+            // Was one line until now
+            shift += std::max<std::uint64_t>(1, static_cast<std::uint64_t>(height / lineHeight + 0.5f)) - 1;
+        }
+        if (shift == 0) return;
+        for (std::size_t i = row < view.rows.size() ? row + 1 : row; i < view.lineStart.size(); i++) view.lineStart[i] += shift;
+    }
+
     // Resolve a resource inside the app bundle's Resources/ directory.
     std::string GetResourcePath(const std::string& filename) {
         CFBundleRef mainBundle = CFBundleGetMainBundle();
@@ -286,6 +373,82 @@ namespace {
         rc = std::system((std::string("open \"") + path + "\"").c_str());
         return rc == 0;
     }
+
+    // Sortable per-system timings from a world's profiler; the render loop
+    // drains it every frame, so this only draws
+    void drawSystemProfile(SystemProfiler& profiler) {
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 8.0f);
+        if (ImGui::Button("Export##SystemProfile")) {
+            std::string dir = ensureProjectRootDir() + "/Profiles";
+            std::error_code ec;
+            fs::create_directories(dir, ec);
+            char stamp[32];
+            const std::time_t now = std::time(nullptr);
+            std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+            profiler.ExportJson(dir + "/systems-" + stamp + ".json");
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Reset##SystemProfile")) {
+            profiler.Reset();
+        }
+        ImGui::PopStyleVar();
+        if (profiler.Dropped() > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("%llu samples dropped", static_cast<unsigned long long>(profiler.Dropped()));
+        }
+
+        const ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                                      ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingFixedFit;
+        if (!ImGui::BeginTable("SystemProfile", 7, flags)) return;
+        ImGui::TableSetupColumn("System", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Last ms", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("Mean ms", ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("Max ms", ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("Entities", ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("Worker");
+        ImGui::TableSetupColumn("Runs", ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableHeadersRow();
+
+        // Values change every frame, so sort every frame rather than only when the specs change
+        const std::vector<SystemProfiler::Stats>& systems = profiler.Systems();
+        static std::vector<std::size_t> order;
+        order.resize(systems.size());
+        for (std::size_t i = 0; i < order.size(); i++) order[i] = i;
+        if (const ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs(); specs && specs->SpecsCount > 0) {
+            const ImGuiTableColumnSortSpecs& spec = specs->Specs[0];
+            auto key = [&](const SystemProfiler::Stats& s) -> double {
+                switch (spec.ColumnIndex) {
+                    case 1: return static_cast<double>(s.lastNanoseconds);
+                    case 2: return s.MeanMilliseconds();
+                    case 3: return static_cast<double>(s.maxNanoseconds);
+                    case 4: return static_cast<double>(s.lastEntities);
+                    case 5: return static_cast<double>(s.lastWorker);
+                    case 6: return static_cast<double>(s.runs);
+                    default: return 0.0;
+                }
+            };
+            const bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                if (spec.ColumnIndex == 0) {
+                    return ascending ? systems[a].name < systems[b].name : systems[b].name < systems[a].name;
+                }
+                return ascending ? key(systems[a]) < key(systems[b]) : key(systems[b]) < key(systems[a]);
+            });
+        }
+
+        for (const std::size_t i : order) {
+            const SystemProfiler::Stats& s = systems[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(s.name.c_str());
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", s.lastNanoseconds / 1e6);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", s.MeanMilliseconds());
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", s.maxNanoseconds / 1e6);
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(s.lastEntities));
+            ImGui::TableNextColumn(); ImGui::Text("%u", s.lastWorker);
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(s.runs));
+        }
+        ImGui::EndTable();
+    }
 }
 
 void UI::draw() {
@@ -316,6 +479,11 @@ void UI::draw() {
         if (ImGui::Begin("Output", &Panels::showOmnix)) {
             // Display FPS at the top
             ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
+            
+            // Per-system timings right under the frame rate
+            if (world != nullptr && ImGui::CollapsingHeader("Systems")) {
+                drawSystemProfile(world->Profiler());
+            }
             ImGui::Separator();
             
             // Button to clear logs with rounded corners
@@ -329,6 +497,18 @@ void UI::draw() {
             // Auto-scroll toggle
             static bool autoScroll = true;
             ImGui::Checkbox("Auto-scroll", &autoScroll);
+            ImGui::SameLine();
+            
+            // Show one log type only
+            static int logFilter = -1;
+            ImGui::SetNextItemWidth(120.0f);
+            if (ImGui::BeginCombo("Show", logFilter < 0 ? "All" : g_logColorNames[logFilter])) {
+                if (ImGui::Selectable("All", logFilter < 0)) logFilter = -1;
+                for (int i = 0; i < 13; i++) {
+                    if (ImGui::Selectable(g_logColorNames[i], logFilter == i)) logFilter = i;
+                }
+                ImGui::EndCombo();
+            }
             
             // Color customization panel (collapsible)
             if (ImGui::CollapsingHeader("Log Colors")) {
@@ -361,7 +541,7 @@ void UI::draw() {
             ImGui::BeginChild("LogScrollArea", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
             
             // Get all logs from Status
-            const std::vector<Status::LogEntry>& logs = Status::GetAllLogs();
+            const Status::LogHistory& logs = Status::GetAllLogs();
             
             // Helper lambda to get color for log type (uses the global customizable colors)
             auto GetLogColor = [&](Status::LogType type) -> ImVec4 {
@@ -403,19 +583,57 @@ void UI::draw() {
                 }
             };
             
-            // Display all logs
-            for (const auto& log : logs) {
-                ImVec4 color = GetLogColor(log.type);
-                ImGui::PushStyleColor(ImGuiCol_Text, color);
-                
-                // Display log type prefix and message
-                ImGui::TextUnformatted(GetLogTypeName(log.type));
-                ImGui::SameLine();
-                ImGui::TextWrapped("%s", log.message.c_str());
-                
-                ImGui::PopStyleColor();
+            // The history is bounded; say so once it has started evicting
+            if (logs.Dropped() != 0) {
+                ImGui::TextDisabled("(%llu older entries dropped)", static_cast<unsigned long long>(logs.Dropped()));
             }
             
+            // Only the visible rows are drawn. The clipper counts wrapped text
+            // lines, and without item spacing every row is a whole number of them
+            LogViewState& view = logViewState();
+            const float width = ImGui::GetContentRegionAvail().x;
+            const float spacing = ImGui::GetStyle().ItemSpacing.x;
+            float wrapWidth[13];
+            for (int i = 0; i < 13; i++) {
+                const float prefix = ImGui::CalcTextSize(GetLogTypeName(static_cast<Status::LogType>(i))).x;
+                wrapWidth[i] = std::max(width - prefix - spacing, 1.0f);
+            }
+            updateLogView(view, logs, width, logFilter);
+            
+            ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(spacing, 0.0f));
+            ImGui::PushTextWrapPos(0.0f);
+            const float lineHeight = ImGui::GetTextLineHeight();
+            const std::uint64_t base = view.lineStart[view.front];
+            // Real heights for the rows about to be shown, before the clipper lays them out
+            const float above = std::max(0.0f, ImGui::GetScrollY() - ImGui::GetCursorPosY());
+            const std::uint64_t firstVisible = base + static_cast<std::uint64_t>(above / lineHeight);
+            measureLogView(view, logs, wrapWidth, firstVisible,
+                           firstVisible + static_cast<std::uint64_t>(ImGui::GetWindowHeight() / lineHeight) + 1);
+            std::string scratch; // text of entries logged with Status::Log
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(view.lineStart.back() - base), lineHeight);
+            while (clipper.Step()) {
+                // The row holding the first visible line may start above it
+                const std::uint64_t firstLine = base + clipper.DisplayStart;
+                std::size_t row = std::upper_bound(view.lineStart.begin() + view.front, view.lineStart.end() - 1, firstLine) -
+                                  view.lineStart.begin() - 1;
+                ImGui::SetCursorPosY(ImGui::GetCursorPosY() - (firstLine - view.lineStart[row]) * lineHeight);
+                for (; row < view.rows.size() && view.lineStart[row] < base + clipper.DisplayEnd; row++) {
+                    const Status::LogEntry log = logs.At(view.rows[row]);
+                    ImGui::PushStyleColor(ImGuiCol_Text, GetLogColor(log.type));
+                    
+                    // Display log type prefix and message
+                    ImGui::TextUnformatted(GetLogTypeName(log.type));
+                    ImGui::SameLine();
+                    const std::string_view text = log.Text(scratch);
+                    ImGui::TextUnformatted(text.data(), text.data() + text.size());
+                    
+                    ImGui::PopStyleColor();
+                }
+            }
+            ImGui::PopTextWrapPos();
+            ImGui::PopStyleVar();
+            
             // Auto-scroll to bottom if enabled
             if (autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
                 ImGui::SetScrollHereY(1.0f);
@@ -2,6 +2,8 @@
 
 #include <string>
 
+class ECS;
+
 // Lightweight UI facade for Dear ImGui widgets
 // Window/context setup and per-frame begin/render are owned by WindowManager.
 
@@ -19,8 +21,12 @@ public:
     // Set the current project name for the file explorer
     static void setProjectName(const std::string& name);
 
+    // World whose systems the Output panel profiles
+    void setWorld(ECS* ecs) { world = ecs; }
+
 private:
    
+    ECS* world = nullptr;
     float scale[3] = {0.5f, 0.5f, 0.5f};
 };
 
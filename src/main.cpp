@@ -6,7 +6,14 @@
 #include "UI.h"
 
 #include "EngineLib/EngineInit.hpp"
+#include "EngineLib/JobSystem.hpp"
+#include "EngineLib/RegistryMaintenance.hpp"
+#include "EngineLib/SceneStreamer.hpp"
+#include "EngineLib/Scheduler.hpp"
+#include "EngineLib/SimulationLoop.hpp"
+#include "EngineLib/SpatialGrid.hpp"
 #include "EngineLib/Status.hpp"
+#include "EngineLib/ecs.hpp"
 
 int main() {
     std::cout << "Starting Omnix..." << std::endl;
@@ -54,12 +61,51 @@ int main() {
     // Set initial fullscreen mode
     windowManager.setFullscreen(true);
     
+    // Stream the default scene in while the editor is already drawing frames
+    JobSystem jobs;
+    ECS ecs;
+    SceneStreamer sceneStreamer(jobs);
+    ecs.StreamScene(sceneStreamer, engineInit.ProjectPath(projectName) + "/Scenes/Default.OmniScene");
+    
+    // Engine systems, one pass per simulation tick; timings show up under Output > Systems
+    Scheduler scheduler(ecs.Registry(), jobs, &ecs.Profiler());
+    scheduler.AddSystem<Reads<Position>>("SpatialGrid", [&ecs](SystemContext& context) {
+        // Re-bucket every Position for this frame's neighbour queries
+        ecs.Grid().Rebuild(&context.Jobs());
+        context.CountVisited(ecs.Grid().Size());
+    });
+    
+    // Re-sorts pools by position and trims drained ones after churn
+    RegistryMaintenance maintenance(ecs.Registry());
+    
+    // Systems tick at a fixed 60 Hz on their own thread, whatever the display does;
+    // maintenance gets the time left over between ticks
+    SimulationLoop simulation(ecs.Registry(), 60.0);
+    simulation.SetStep([&scheduler](double) { scheduler.Run(); });
+    simulation.SetIdle([&maintenance](double budgetMs) { maintenance.Step(budgetMs); });
+    simulation.Start();
+    std::vector<WorldMatrix> entityTransforms;
+    
     // Main render loop
     UI ui;
+    ui.setWorld(&ecs);
     while (!windowManager.shouldClose()) {
         // Poll events and handle input
         windowManager.pollEvents();
         
+        // Insert streamed scene batches within a small per-frame budget, between ticks
+        {
+            auto world = simulation.LockWorld();
+            sceneStreamer.Pump();
+        }
+        
+        // Entity transforms blended between the last two ticks
+        simulation.Interpolate(entityTransforms);
+        
+        // The profiler's sample ring is bounded, so drain it every frame even
+        // while the Systems table is collapsed or the Output panel is closed
+        ecs.Profiler().Drain();
+        
         // Start UI frame
         windowManager.beginImGuiFrame();
 
@@ -70,7 +116,7 @@ int main() {
         float aspectRatio = windowManager.getAspectRatio();
         
         // Render scene with UI-driven cube scaling
-        renderer.render(camera, aspectRatio, &ui);
+        renderer.render(camera, aspectRatio, &ui, &entityTransforms);
 
         // Render UI on top
         windowManager.renderImGui();
@@ -82,6 +128,7 @@ int main() {
     std::cout << "Shutting down Omnix..." << std::endl;
     
     // Cleanup
+    simulation.Stop();
     renderer.cleanup();
     windowManager.cleanup();
     